@@ -0,0 +1,39 @@
+#include "Bench/BenchmarkConfig.h"
+#include "Bench/BenchmarkRunner.h"
+#include "Bench/ResultWriter.h"
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char** argv)
+{
+    using namespace Bench;
+
+    BenchmarkConfig config;
+    std::string error;
+
+    if (!parseArguments(argc, argv, config, error))
+    {
+        if (!error.empty()) std::cerr << error << "\n";
+        printUsage();
+        return error.empty() ? 0 : 1;
+    }
+
+    if (!config.sort_file_path.empty()) return BenchmarkRunner(config).sortFile() ? 0 : 2;
+
+    std::ofstream output_file;
+    if (!config.output_path.empty())
+    {
+        output_file.open(config.output_path);
+        if (!output_file.is_open())
+        {
+            std::cerr << "cannot open " << config.output_path << "\n";
+            return 1;
+        }
+    }
+
+    ResultWriter result_writer(config.output_path.empty() ? std::cout : output_file, config.output_format);
+    BenchmarkRunner benchmark_runner(config);
+    if (!benchmark_runner.open()) return 1;
+
+    return benchmark_runner.run(result_writer) ? 0 : 2;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include "Sort/SortType.h"
+#include "Sort/Input/Distribution.h"
+#include "Sort/Input/Dataset.h"
+#include "Sort/Metrics/CacheSimulator.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Bench
+{
+    enum class OutputFormat
+    {
+        CSV,
+        JSON,
+    };
+
+    struct BenchmarkConfig
+    {
+        std::vector<Sort::SortType> sort_types;
+        std::vector<Sort::Input::Distribution> distributions;
+
+        // N sweeps powers of ten from min_size to max_size
+        std::size_t min_size = 1000;
+        std::size_t max_size = 100000000;
+
+        // O(n^2) sorts stop here, they would take days at the top of the sweep
+        std::size_t max_quadratic_size = 100000;
+
+        // Comparisons and array accesses come from an extra instrumented run, skipped above this size
+        std::size_t max_counted_size = 1000000;
+
+        // The instrumented run can also replay its accesses through simulated caches, several times slower
+        bool is_cache_model_enabled = false;
+        Sort::Metrics::CacheConfig cache_config = Sort::Metrics::CacheSimulator::getDefaultConfig();
+
+        // Cycles, instructions, branch and cache misses of the fastest timed run, where the kernel allows it
+        bool is_hardware_counters_enabled = true;
+
+        // Threads of the native merge and quick sorts, 0 uses every core
+        unsigned number_of_threads = 0;
+
+        // Children per node of the heap sort's heap, 2, 4 or 8
+        unsigned heap_arity = 4;
+
+        // The external merge sort's memory, and where it puts the array's files and its runs
+        std::size_t external_memory_budget = std::size_t(64) << 20;
+        std::string external_path = "sorting-bench-external";
+
+        // Key type of the generated distributions. Other than int32 they are sorted by BasicSortEngine, without
+        // the parallel and external sorts; a dataset is always sorted in its own key type.
+        Sort::Input::DatasetType key_type = Sort::Input::DatasetType::INT32;
+
+        // When set, the sweep sorts the first N keys of this file instead of the generated distributions;
+        // dataset_type is the key type of a file without a header
+        std::string dataset_path;
+        Sort::Input::DatasetType dataset_type = Sort::Input::DatasetType::INT32;
+
+        // When set, sort_file_path is sorted into sorted_file_path by the external merge sort instead of the sweep
+        std::string sort_file_path;
+        std::string sorted_file_path;
+
+        int warmup_runs = 1;
+        int repetitions = 5;
+        std::uint64_t seed = 42;
+
+        OutputFormat output_format = OutputFormat::CSV;
+        std::string output_path; //empty writes to stdout
+    };
+
+    bool parseArguments(int argc, char** argv, BenchmarkConfig& config, std::string& error);
+    void printUsage();
+
+    const char* getSortName(Sort::SortType sort_type);
+}
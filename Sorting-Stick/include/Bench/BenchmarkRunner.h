@@ -0,0 +1,43 @@
+#pragma once
+#include "Bench/BenchmarkConfig.h"
+#include "Bench/OperationCounter.h"
+#include "Bench/HardwareCounters.h"
+#include "Bench/ResultWriter.h"
+#include "Bench/KeyArray.h"
+#include "Sort/Input/InputGenerator.h"
+
+namespace Bench
+{
+    // Runs every configured sort over the size sweep and distributions, without a window.
+    class BenchmarkRunner
+    {
+    private:
+        const BenchmarkConfig& config;
+
+        OperationCounter* operation_counter;
+        HardwareCounters* hardware_counters;
+        Sort::Input::InputGenerator* input_generator;
+        Sort::Input::Dataset* dataset;
+        KeyArray* key_array;
+
+        bool isQuadratic(Sort::SortType sort_type);
+        bool isOutputCorrect(std::size_t size);
+
+        BenchmarkResult runCase(Sort::SortType sort_type, Sort::Input::Distribution distribution, std::size_t size);
+        double timeSort(Sort::SortType sort_type, HardwareCounts& hardware_counts);
+        void countOperations(Sort::SortType sort_type, BenchmarkResult& result);
+
+    public:
+        BenchmarkRunner(const BenchmarkConfig& config);
+        ~BenchmarkRunner();
+
+        // Loads the dataset, if there is one, and the keys to sort; returns false if the dataset can't be read
+        bool open();
+
+        // Returns false if any sort produced unsorted output, or lost keys
+        bool run(ResultWriter& result_writer);
+
+        // Sorts config.sort_file_path into config.sorted_file_path, returns false if the sort failed
+        bool sortFile();
+    };
+}
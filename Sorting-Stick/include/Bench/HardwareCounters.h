@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace Bench
+{
+    enum class HardwareEvent
+    {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        L1D_MISSES,
+        LLC_MISSES,
+        STALLED_CYCLES,
+    };
+
+    const int number_of_hardware_events = 6;
+
+    struct HardwareCounts
+    {
+        bool is_counted[number_of_hardware_events] = {};
+        std::uint64_t values[number_of_hardware_events] = {};
+
+        bool has(HardwareEvent event) const { return is_counted[static_cast<int>(event)]; }
+        std::uint64_t get(HardwareEvent event) const { return values[static_cast<int>(event)]; }
+    };
+
+    // One perf_event_open group of user-space counters around a sort, Linux only.
+    // Events the CPU or kernel does not offer are left out of the group; if even the cycle counter
+    // is refused (perf_event_paranoid, containers, other platforms) the counters are unavailable
+    // and the bench falls back to timing only.
+    class HardwareCounters
+    {
+    private:
+        int event_descriptors[number_of_hardware_events];
+        std::string error;
+
+        void close();
+
+    public:
+        HardwareCounters();
+        ~HardwareCounters();
+
+        HardwareCounters(const HardwareCounters&) = delete;
+        HardwareCounters& operator=(const HardwareCounters&) = delete;
+
+        bool open();
+        bool isAvailable() const;
+        const std::string& getError() const;
+
+        void start();
+        HardwareCounts stop();
+
+        static const char* getEventName(HardwareEvent event);
+    };
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "Bench/BenchmarkConfig.h"
+#include "Bench/OperationCounter.h"
+#include "Sort/SortType.h"
+#include "Sort/SortEngine.h"
+#include "Sort/BasicSortEngine.h"
+#include "Sort/RadixKey.h"
+#include "Sort/Input/Distribution.h"
+#include "Sort/Input/Dataset.h"
+#include "Sort/Input/InputGenerator.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace Bench
+{
+    // The input of one benchmark case and the copy of it that gets sorted, in the key type being measured.
+    class KeyArray
+    {
+    public:
+        virtual ~KeyArray() = default;
+
+        // Takes size keys of the distribution as the input, false if a dataset has fewer
+        virtual bool load(Sort::Input::Distribution distribution, std::size_t size) = 0;
+
+        // Copies the input over the keys, the sort then runs on them
+        virtual void reset() = 0;
+        virtual void sort(Sort::SortType sort_type) = 0;
+        virtual void countOperations(Sort::SortType sort_type, OperationCounter& operation_counter) = 0;
+
+        virtual bool isSorted() const = 0;
+
+        // Whether the keys hold exactly the input's bit patterns, which tells -0.0 from 0.0 and keeps NaNs
+        virtual bool isPermutation() const = 0;
+
+        virtual std::size_t getSize() const = 0;
+    };
+
+    // int keys go through SortEngine, with its parallel and external sorts
+    class IntKeyArray : public KeyArray
+    {
+    private:
+        Sort::SortEngine* sort_engine;
+        Sort::Input::InputGenerator& input_generator;
+        const Sort::Input::Dataset& dataset;
+
+        std::vector<int> input_keys;
+        std::vector<int> keys;
+
+    public:
+        IntKeyArray(const BenchmarkConfig& config, Sort::Input::InputGenerator& input_generator, const Sort::Input::Dataset& dataset);
+        ~IntKeyArray();
+
+        bool load(Sort::Input::Distribution distribution, std::size_t size) override;
+        void reset() override;
+        void sort(Sort::SortType sort_type) override;
+        void countOperations(Sort::SortType sort_type, OperationCounter& operation_counter) override;
+        bool isSorted() const override;
+        bool isPermutation() const override;
+        std::size_t getSize() const override;
+    };
+
+    // Other key types go through their own BasicSortEngine instantiation. A dataset's keys are sorted as they are
+    // in the file; generated distributions are cast from their int keys, floating ones halved with every other
+    // zero negative, so a sort that mixes up -0.0 and 0.0 shows in isPermutation.
+    template<typename Key>
+    class TypedKeyArray : public KeyArray
+    {
+    private:
+        Sort::BasicSortEngine<Key> sort_engine;
+        Sort::Input::InputGenerator& input_generator;
+        const Sort::Input::Dataset& dataset;
+
+        std::vector<int> generated_keys;
+        std::vector<Key> input_keys;
+        std::vector<Key> keys;
+
+        static Key convert(int key, std::size_t index, std::true_type)
+        {
+            Key value = static_cast<Key>(key) / 2;
+            return key == 0 && index % 2 == 1 ? -value : value;
+        }
+
+        static Key convert(int key, std::size_t, std::false_type) { return static_cast<Key>(key); }
+
+        static std::vector<typename Sort::RadixKey<Key>::Bits> getSortedBits(const std::vector<Key>& keys)
+        {
+            std::vector<typename Sort::RadixKey<Key>::Bits> bits(keys.size());
+            for (std::size_t i = 0; i < keys.size(); i++) bits[i] = Sort::RadixKey<Key>::toBits(keys[i]);
+            std::sort(bits.begin(), bits.end());
+            return bits;
+        }
+
+    public:
+        TypedKeyArray(const BenchmarkConfig& config, Sort::Input::InputGenerator& input_generator, const Sort::Input::Dataset& dataset)
+            : input_generator(input_generator), dataset(dataset)
+        {
+            sort_engine.setHeapArity(config.heap_arity);
+        }
+
+        bool load(Sort::Input::Distribution distribution, std::size_t size) override
+        {
+            if (distribution == Sort::Input::Distribution::DATASET)
+            {
+                const Key* dataset_keys = dataset.getKeys<Key>();
+                if (!dataset_keys || size > dataset.getNumberOfKeys()) return false;
+
+                input_keys.assign(dataset_keys, dataset_keys + size);
+                return true;
+            }
+
+            generated_keys.resize(size);
+            input_generator.generate(distribution, generated_keys.data(), size);
+
+            input_keys.resize(size);
+            for (std::size_t i = 0; i < size; i++) input_keys[i] = convert(generated_keys[i], i, std::is_floating_point<Key>());
+            return true;
+        }
+
+        void reset() override { keys = input_keys; }
+
+        void sort(Sort::SortType sort_type) override
+        {
+            sort_engine.setOperationCounters(nullptr);
+            sort_engine.sort(sort_type, keys.data(), keys.size());
+        }
+
+        void countOperations(Sort::SortType sort_type, OperationCounter& operation_counter) override
+        {
+            operation_counter.reset(keys.size(), sizeof(Key));
+            sort_engine.setOperationCounters(operation_counter.getOperationCounters(), operation_counter.getMemoryModel());
+            sort_engine.sort(sort_type, keys.data(), keys.size());
+            sort_engine.setOperationCounters(nullptr);
+        }
+
+        bool isSorted() const override { return std::is_sorted(keys.begin(), keys.end(), std::less<Key>()); }
+        bool isPermutation() const override { return getSortedBits(keys) == getSortedBits(input_keys); }
+        std::size_t getSize() const override { return keys.size(); }
+    };
+
+    // The array for config.key_type, or the dataset's own key type when one is loaded
+    KeyArray* createKeyArray(const BenchmarkConfig& config, Sort::Input::InputGenerator& input_generator, const Sort::Input::Dataset& dataset);
+}
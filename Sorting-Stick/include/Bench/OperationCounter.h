@@ -0,0 +1,31 @@
+#pragma once
+#include "Sort/Metrics/OperationCounters.h"
+#include "Sort/Metrics/MemoryModel.h"
+
+namespace Bench
+{
+    // The counters and, optionally, the cache model that the engine counts into on the instrumented run.
+    class OperationCounter
+    {
+    private:
+        Sort::Metrics::OperationCounters<> operation_counters;
+        Sort::Metrics::MemoryModel memory_model;
+        bool is_memory_model_enabled;
+
+    public:
+        static const bool is_enabled = Sort::Metrics::OperationCounters<>::is_enabled;
+
+        OperationCounter();
+
+        void enableMemoryModel(const Sort::Metrics::CacheConfig& cache_config);
+        bool isMemoryModelEnabled() const;
+
+        void reset(std::size_t size, std::size_t element_size = sizeof(int));
+
+        Sort::Metrics::OperationCounters<>* getOperationCounters();
+        Sort::Metrics::MemoryModel* getMemoryModel(); //null unless enabled
+
+        Sort::Metrics::CounterValues getCounterValues() const;
+        const Sort::Metrics::CacheStatistics& getCacheStatistics() const;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include "Bench/BenchmarkConfig.h"
+#include "Bench/HardwareCounters.h"
+#include "Sort/Metrics/CounterRegistry.h"
+#include "Sort/Metrics/CacheSimulator.h"
+#include <cstdint>
+#include <ostream>
+
+namespace Bench
+{
+    struct BenchmarkResult
+    {
+        Sort::SortType sort_type;
+        Sort::Input::Distribution distribution;
+        std::size_t size;
+        int repetitions;
+
+        double best_ns_per_element;
+        double median_ns_per_element;
+        double throughput; //million keys per second, from the best run
+        HardwareCounts hardware_counts; //from the best run, each event only where it was counted
+
+        // Only meaningful when is_counted is set, see BenchmarkConfig::max_counted_size and SORT_DISABLE_COUNTERS
+        bool is_counted;
+        Sort::Metrics::CounterValues counter_values;
+
+        // Estimated from the instrumented run when BenchmarkConfig::is_cache_model_enabled is set
+        bool is_cache_modelled;
+        Sort::Metrics::CacheStatistics cache_statistics;
+    };
+
+    // Streams results as CSV rows or a JSON array, one result at a time so long sweeps can be watched as they run.
+    class ResultWriter
+    {
+    private:
+        std::ostream& output;
+        OutputFormat output_format;
+        int number_of_results;
+
+        void writeCSV(const BenchmarkResult& result);
+        void writeCacheCSV(const BenchmarkResult& result);
+        void writeCacheJSON(const BenchmarkResult& result);
+        void writeJSON(const BenchmarkResult& result);
+
+    public:
+        ResultWriter(std::ostream& output, OutputFormat output_format);
+
+        void begin();
+        void write(const BenchmarkResult& result);
+        void end();
+    };
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <SFML/System/Clock.hpp>
+#include <cstdint>
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        enum class ScheduleMode
+        {
+            OPERATIONS_PER_SECOND,
+            OPERATIONS_PER_FRAME,
+            TIME_BUDGET,
+        };
+
+        // One setting of the gameplay screen's speed control: amount is operations per second or per frame,
+        // or the microseconds of a frame's time budget, depending on the mode
+        struct ReplaySpeed
+        {
+            ScheduleMode schedule_mode;
+            double amount;
+            const char* title;
+        };
+
+        // Decides how many trace operations get applied in the current frame. Slow speeds spread single
+        // operations over several frames, fast speeds apply thousands per frame and only the last state is drawn.
+        class StepScheduler
+        {
+        private:
+            const std::uint64_t time_check_interval = 256;
+            const float max_carried_seconds = 0.25f;
+
+            ScheduleMode schedule_mode;
+            double operations_per_second;
+            std::uint64_t operations_per_frame;
+            std::int64_t time_budget_microseconds;
+
+            double available_operations;
+            double measured_operations_per_second;
+            std::uint64_t frame_steps;
+            std::uint64_t frame_checks; //canStep calls, free operations included
+            bool frame_exhausted;
+
+            sf::Clock frame_clock;
+            sf::Clock budget_clock;
+
+        public:
+            StepScheduler();
+            ~StepScheduler();
+
+            void setOperationsPerSecond(double operations);
+            void setOperationsPerFrame(std::uint64_t operations);
+            void setTimeBudget(std::int64_t microseconds);
+
+            void reset();
+            void beginFrame();
+            bool canStep();
+            void step();
+
+            ScheduleMode getScheduleMode();
+            double getOperationsPerSecond();
+        };
+    }
+}
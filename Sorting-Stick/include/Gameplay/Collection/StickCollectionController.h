@@ -2,6 +2,20 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <utility>
+#include "Sort/SortType.h"
+#include "Sort/SortEngine.h"
+#include "Sort/Trace/TraceRecorder.h"
+#include "Sort/Trace/TracePlayer.h"
+#include "Sort/Input/InputGenerator.h"
+#include "Sort/Input/Dataset.h"
+#include "Sort/Metrics/OperationCounters.h"
+#include "Sort/Metrics/MemoryModel.h"
+#include "Gameplay/Collection/StepScheduler.h"
+#include "Gameplay/Collection/StickCollectionSnapshot.h"
+#include "Global/TripleBuffer.h"
+#include "Global/StopToken.h"
 
 namespace Gameplay
 {
@@ -9,8 +23,6 @@ namespace Gameplay
     {
         class StickCollectionView;
         class StickCollectionModel;
-        struct Stick;
-        enum class SortType;
         enum class SortState;
 
         class StickCollectionController
@@ -19,14 +31,51 @@ namespace Gameplay
             StickCollectionView* collection_view;
             StickCollectionModel* collection_model;
 
-            std::vector<Stick*> sticks;
-            SortType sort_type;
+            // Struct-of-arrays stick storage: index i is the stick drawn at position i,
+            // its height and position are derived from stick_keys[i] when the view is refreshed
+            std::vector<int> stick_keys;
+            std::vector<sf::Color> stick_colors;
+            float stick_width;
+            Sort::SortType sort_type;
+
+            Sort::Input::InputGenerator* input_generator;
+            Sort::Input::Distribution input_distribution;
+            Sort::Input::Dataset* dataset; //only open when it holds enough keys for every stick
+
+            Sort::SortEngine* sort_engine;
+            std::vector<int> sort_keys;
+
+            Sort::Trace::TraceRecorder* trace_recorder;
+            Sort::Trace::TracePlayer* trace_player;
 
             std::thread sort_thread;
+            Global::StopSource sort_stop_source;
+            std::atomic<bool> is_sort_finished; //set by the sort thread after its final snapshot is published
+
+            // Owned by the sort thread while a sort runs; the render side only sees published snapshots
+            StepScheduler* step_scheduler;
+            int applied_replay_speed; //the replay_speed the scheduler is set to, -1 before the first frame
+            std::vector<int> replay_keys;
+            std::vector<sf::Color> replay_colors;
+            std::vector<std::pair<int, sf::Color>> flashed_sticks;
+            bool compare_sound_played;
+            int number_of_runs; //natural runs shown so far, alternating the run colors
+            Sort::Metrics::MemoryModel* memory_model;
+
+            // Counted by the sort thread as it replays, read by the UI every frame; reset only while no sort thread runs
+            Sort::Metrics::OperationCounters<> operation_counters;
+
+            Global::TripleBuffer<StickCollectionSnapshot> snapshot_buffer;
+
+            std::vector<bool> dirty_sticks;
+            std::vector<int> dirty_stick_indices;
 
-            int number_of_comparisons;
-            int number_of_array_access;
-            int current_operation_delay;
+            Sort::Metrics::CacheStatistics cache_statistics;
+
+            // Picked by the UI, applied by the sort thread at the start of its next frame
+            std::atomic<int> replay_speed;
+            ScheduleMode schedule_mode;
+            double operations_per_second;
 
             int delay_in_ms;
             sf::String time_complexity;
@@ -41,38 +90,35 @@ namespace Gameplay
 
             void updateStickPosition();
             void updateStickPosition(int i);
-            void shuffleSticks();
-            bool compareSticksByData(const Stick* a, const Stick* b) const;
+            void generateSticks();
+
+            void setStickData(int i, int data);
+            void setStickColor(int i, sf::Color color);
+            void refreshStickViews();
+            sf::Color getHighlightColor(Sort::HighlightType highlight_type);
 
             void resetSticksColor();
             void resetVariables();
 
             void processSortThreadState();
+            void applySnapshot(const StickCollectionSnapshot& snapshot);
 
-            bool isCollectionSorted();
+            void stopSortThread();
             void destroy();
 
-            void setCompletedColor();
-
-            void processBubbleSort();
-            void processInsertionSort();
-            void processSelectionSort();
-            void processInPlaceMergeSort();
-            void processMergeSort();
-            void processQuickSort();
-            void processRadixSort();
-
-            void inPlaceMerge(int left, int mid, int right);
-            void inPlaceMergeSort(int left,int right);
-
-            void outPlaceMergeSort(int left, int right);
-            void outPlaceMerge(int left, int mid, int right);
-
-            void quickSort(int low, int high);
-            int partition(int low, int high);
-
-            void radixSort();
-            void countSort(int exponent);
+            void processSort(Global::StopToken stop_token);
+            void recordSort(const Global::StopToken& stop_token);
+            bool startReplay();
+            void processReplay(const Global::StopToken& stop_token);
+            void applyReplaySpeed();
+            void processCompletion(const Global::StopToken& stop_token);
+            void applyOperation(const Sort::SortOperation& operation);
+            void flashStick(int i);
+            void restoreFlashedSticks();
+            void colorRun(int begin, int end);
+            void colorHeap(int begin, int end);
+            void colorRange(int begin, int end, sf::Color color);
+            void publishSnapshot(SortState state);
 
         public:
             StickCollectionController();
@@ -83,15 +129,23 @@ namespace Gameplay
             void render();
 
             void reset();
-            void sortElements(SortType sort_type);
+            void sortElements(Sort::SortType sort_type);
+            void setInputDistribution(Sort::Input::Distribution distribution);
+            void cycleReplaySpeed();
 
-            SortType getSortType();
+            Sort::SortType getSortType();
+            Sort::Input::Distribution getInputDistribution();
+            bool hasDataset();
             int getNumberOfComparisons();
             int getNumberOfArrayAccess();
+            bool isCacheModelEnabled();
+            const Sort::Metrics::CacheStatistics& getCacheStatistics();
 
             int getNumberOfSticks();
-            int getDelayMilliseconds();
+            const char* getReplaySpeedTitle();
+            ScheduleMode getScheduleMode();
+            int getOperationsPerSecond();
             sf::String getTimeComplexity();
         };
     }
-}
\ No newline at end of file
+}
@@ -1,23 +1,20 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Sort/SortType.h"
+#include "Sort/Metrics/CacheSimulator.h"
+#include "Gameplay/Collection/StepScheduler.h"
 
 namespace Gameplay
 {
     namespace Collection
     {
-        enum class SortType
-        {
-            BUBBLE_SORT,
-            INSERTION_SORT,
-            SELECTION_SORT,
-            MERGE_SORT,
-            QUICK_SORT,
-            RADIX_SORT,
-        };
+        using Sort::SortType;
 
         enum class SortState
         {
-            SORTING,
+            RECORDING,
+            REPLAYING,
+            COMPLETING,
             NOT_SORTING
         };
 
@@ -35,11 +32,32 @@ namespace Gameplay
             const sf::Color placement_position_element_color = sf::Color::Green;
             const sf::Color selected_element_color = sf::Color::Blue;
             const sf::Color temporary_processing_color = sf::Color::Yellow;
+            const sf::Color less_element_color = sf::Color(255, 140, 0); //the three bands of a three-way partition: less, equal (placed) and greater
+            const sf::Color greater_element_color = sf::Color(160, 32, 240);
+            const sf::Color run_colors[2] = { sf::Color::Cyan, sf::Color::Magenta }; //alternated between neighbouring natural runs
+            const sf::Color heap_level_colors[2] = { sf::Color::Cyan, sf::Color::Magenta }; //alternated between the levels of a heap
+            const unsigned heap_arity = 4;
+            const std::size_t external_memory_budget = 300; //bytes, three buffers of 25 sticks so the external sort merges 8 runs
 
-            const long operation_delay = 40;
+            // The speeds clicking the speed text cycles through, starting at one operation every 40 ms. A replay frame
+            // lasts publish_interval, so 100 per frame is about 12500 operations a second.
+            static const int number_of_replay_speeds = 5;
+            const ReplaySpeed replay_speeds[number_of_replay_speeds] = {
+                { ScheduleMode::OPERATIONS_PER_SECOND, 25.0, "25 / s" },
+                { ScheduleMode::OPERATIONS_PER_SECOND, 250.0, "250 / s" },
+                { ScheduleMode::OPERATIONS_PER_FRAME, 100.0, "100 / frame" },
+                { ScheduleMode::TIME_BUDGET, 2000.0, "2 ms / frame" },
+                { ScheduleMode::OPERATIONS_PER_SECOND, 1.0, "1 / s" },
+            };
+            const long publish_interval = 8; //ms between snapshots published by the sort thread
 
             const long initial_color_delay = 40;
 
+            // Caches scaled down to the stick array, which would otherwise fit in any real L1: 16 byte lines,
+            // 128 B 2-way L1, 512 B 4-way L2 and 1 KiB 8-way LLC against 800 B of keys plus 800 B of scratch
+            const bool is_cache_model_enabled = true;
+            const Sort::Metrics::CacheConfig cache_config = { { { 128, 16, 2 }, { 512, 16, 4 }, { 1024, 16, 8 } } };
+
             StickCollectionModel();
             ~StickCollectionModel();
 
@@ -0,0 +1,24 @@
+#pragma once
+#include <SFML/Graphics/Color.hpp>
+#include <vector>
+#include "Gameplay/Collection/StickCollectionModel.h"
+#include "Sort/Metrics/CacheSimulator.h"
+
+namespace Gameplay
+{
+    namespace Collection
+    {
+        // Complete stick state as published by the sort thread once per step batch.
+        struct StickCollectionSnapshot
+        {
+            std::vector<int> keys;
+            std::vector<sf::Color> colors;
+
+            SortState sort_state = SortState::NOT_SORTING;
+            Sort::Metrics::CacheStatistics cache_statistics;
+            ScheduleMode schedule_mode = ScheduleMode::OPERATIONS_PER_SECOND;
+            double operations_per_second = 0; //the set rate, or the measured one when the steps are counted per frame
+            bool play_compare_sound = false;
+        };
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "UI/UIElement/ImageView.h"
+#include "UI/UIElement/RectangleBatchView.h"
 
 namespace Gameplay
 {
@@ -12,6 +13,7 @@ namespace Gameplay
         {
         private:
             StickCollectionController* collection_controller;
+            UI::UIElement::RectangleBatchView* sticks_batch_view;
 
         public:
             StickCollectionView();
@@ -20,6 +22,9 @@ namespace Gameplay
             void initialize(StickCollectionController* collection_controller);
             void update();
             void render();
+
+            void setStickRectangle(int index, sf::Vector2f stick_size, sf::Vector2f stick_position);
+            void setStickColor(int index, sf::Color stick_color);
         };
     }
-}
\ No newline at end of file
+}
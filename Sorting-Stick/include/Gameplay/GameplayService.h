@@ -23,12 +23,20 @@ namespace Gameplay
 
 		void reset();
 		void sortElement(Collection::SortType search_type);
+		void setInputDistribution(Sort::Input::Distribution distribution);
+		void cycleReplaySpeed();
 
 		Collection::SortType getSortType();
+		Sort::Input::Distribution getInputDistribution();
+		bool hasDataset();
 		int getNumberOfComparisons();
 		int getNumberOfArrayAccess();
+		bool isCacheModelEnabled();
+		const Sort::Metrics::CacheStatistics& getCacheStatistics();
 		int getNumberOfSticks();
-		int getDelayMilliseconds();
+		const char* getReplaySpeedTitle();
+		Collection::ScheduleMode getScheduleMode();
+		int getOperationsPerSecond();
 		sf::String getTimeComplexity();
 	};
 }
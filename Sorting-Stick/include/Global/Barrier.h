@@ -0,0 +1,38 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace Global
+{
+	// Reusable thread barrier in the spirit of std::barrier: wait() blocks until the given number of
+	// threads have called it, then releases all of them and resets for the next phase.
+	class Barrier
+	{
+	private:
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::size_t number_of_threads;
+		std::size_t number_waiting;
+		std::size_t generation;
+
+	public:
+		explicit Barrier(std::size_t number_of_threads) : number_of_threads(number_of_threads), number_waiting(0), generation(0) { }
+
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			std::size_t arrival_generation = generation;
+
+			if (++number_waiting == number_of_threads)
+			{
+				number_waiting = 0;
+				generation++;
+				condition.notify_all();
+				return;
+			}
+
+			condition.wait(lock, [this, arrival_generation] { return generation != arrival_generation; });
+		}
+	};
+}
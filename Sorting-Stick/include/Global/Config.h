@@ -24,5 +24,9 @@ namespace Global
 		static const sf::String compare_sfx_sound_path;
 		static const sf::String button_click_sound_path;
 		static const sf::String scream_sound_path;
+
+		static const sf::String sort_trace_path;
+		static const sf::String external_sort_path;
+		static const sf::String stick_dataset_path;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace Global
+{
+	// Read-only memory mapping of a whole file. Pages are brought in by the OS on demand,
+	// so files far larger than RAM can be walked without loading them up front.
+	class MappedFile
+	{
+	private:
+		const unsigned char* data;
+		std::size_t size;
+
+#ifdef _WIN32
+		void* file_handle;
+		void* mapping_handle;
+#else
+		int file_descriptor;
+#endif
+
+	public:
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		bool open(const std::string& path);
+		void close();
+
+		void adviseSequential();
+
+		bool isOpen() const;
+		const unsigned char* getData() const;
+		std::size_t getSize() const;
+	};
+}
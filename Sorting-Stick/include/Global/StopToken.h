@@ -0,0 +1,67 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+namespace Global
+{
+	// Shared state between a StopSource and the tokens handed out by it.
+	struct StopState
+	{
+		std::atomic<bool> stop_requested;
+		std::mutex mutex;
+		std::condition_variable condition;
+
+		StopState() : stop_requested(false) { }
+	};
+
+	// Read side of a stop request, in the spirit of std::stop_token.
+	// Checking is a single atomic load, waiting wakes up as soon as a stop is requested.
+	class StopToken
+	{
+	private:
+		std::shared_ptr<StopState> stop_state;
+
+	public:
+		StopToken() { }
+		explicit StopToken(std::shared_ptr<StopState> stop_state) : stop_state(std::move(stop_state)) { }
+
+		bool isStopRequested() const
+		{
+			return stop_state && stop_state->stop_requested.load(std::memory_order_acquire);
+		}
+
+		// Sleeps for the given duration or until a stop is requested, returns true if it was
+		template<typename Rep, typename Period>
+		bool waitFor(const std::chrono::duration<Rep, Period>& duration) const
+		{
+			if (!stop_state) return false;
+
+			std::unique_lock<std::mutex> lock(stop_state->mutex);
+			return stop_state->condition.wait_for(lock, duration, [this] { return isStopRequested(); });
+		}
+	};
+
+	// Write side of a stop request. Every sort run gets a fresh source so a stale request never leaks into the next one.
+	class StopSource
+	{
+	private:
+		std::shared_ptr<StopState> stop_state;
+
+	public:
+		StopSource() : stop_state(std::make_shared<StopState>()) { }
+
+		StopToken getToken() const { return StopToken(stop_state); }
+
+		void requestStop()
+		{
+			{
+				std::lock_guard<std::mutex> lock(stop_state->mutex);
+				stop_state->stop_requested.store(true, std::memory_order_release);
+			}
+			stop_state->condition.notify_all();
+		}
+	};
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+
+namespace Global
+{
+	// Lock-free single producer / single consumer triple buffer.
+	// The producer fills the write buffer and publishes it, the consumer picks up the newest published buffer.
+	// Neither side ever waits for the other and the consumer never sees a buffer that is still being written.
+	template<typename T>
+	class TripleBuffer
+	{
+	private:
+		static const unsigned char index_mask = 3;
+		static const unsigned char fresh_bit = 4;
+
+		T buffers[3];
+
+		// Index of the buffer sitting between producer and consumer, plus whether it is newer than the read buffer
+		std::atomic<unsigned char> shared_state;
+		unsigned char write_index;
+		unsigned char read_index;
+
+	public:
+		TripleBuffer()
+		{
+			shared_state = 1;
+			write_index = 0;
+			read_index = 2;
+		}
+
+		T& getWriteBuffer() { return buffers[write_index]; }
+
+		void publish()
+		{
+			unsigned char previous_state = shared_state.exchange(write_index | fresh_bit, std::memory_order_acq_rel);
+			write_index = previous_state & index_mask;
+		}
+
+		bool consume()
+		{
+			if (!(shared_state.load(std::memory_order_relaxed) & fresh_bit)) return false;
+
+			unsigned char previous_state = shared_state.exchange(read_index, std::memory_order_acq_rel);
+			read_index = previous_state & index_mask;
+			return true;
+		}
+
+		const T& getReadBuffer() const { return buffers[read_index]; }
+	};
+}
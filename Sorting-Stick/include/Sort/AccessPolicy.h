@@ -0,0 +1,84 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Sort/Interface/IOperationSink.h"
+#include "Sort/Metrics/OperationCounters.h"
+#include "Sort/Metrics/MemoryModel.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace Sort
+{
+    // Access policies decide what an InstrumentedArray does besides the load or store itself.
+    // Each one offers the same members; the native one leaves them all empty so they compile away.
+
+    // Raw loads and stores, nothing reported and never cancelled
+    class NativeAccess
+    {
+    public:
+        static const bool is_native = true;
+        static const bool is_visual = false;
+
+        void emit(OperationType, std::size_t, std::size_t = 0, int = 0) { }
+
+        template<typename Key>
+        void emitWrite(std::size_t, const Key&) { }
+
+        bool isCancelled() const { return false; }
+    };
+
+    // Counts every access straight into operation counters, and optionally the cache model, with no virtual calls
+    class CountingAccess
+    {
+    private:
+        Metrics::OperationCounters<>* operation_counters;
+        Metrics::MemoryModel* memory_model;
+
+    public:
+        static const bool is_native = false;
+        static const bool is_visual = false;
+
+        CountingAccess(Metrics::OperationCounters<>* operation_counters, Metrics::MemoryModel* memory_model = nullptr)
+            : operation_counters(operation_counters), memory_model(memory_model) { }
+
+        void emit(OperationType type, std::size_t first, std::size_t second = 0, int value = 0)
+        {
+            SortOperation operation{ type, first, second, value };
+            operation_counters->count(operation);
+            if (memory_model) memory_model->access(operation);
+        }
+
+        // The written key does not change any count
+        template<typename Key>
+        void emitWrite(std::size_t index, const Key&) { emit(OperationType::WRITE, index); }
+
+        bool isCancelled() const { return false; }
+    };
+
+    // Reports every operation, highlights included, to a sink such as the trace recorder
+    class VisualAccess
+    {
+    private:
+        Interface::IOperationSink* operation_sink;
+
+    public:
+        static const bool is_native = false;
+        static const bool is_visual = true; //highlights are only worth a loop when something shows them
+
+        explicit VisualAccess(Interface::IOperationSink* operation_sink) : operation_sink(operation_sink) { }
+
+        void emit(OperationType type, std::size_t first, std::size_t second = 0, int value = 0)
+        {
+            operation_sink->onOperation(SortOperation{ type, first, second, value });
+        }
+
+        // The stick view needs the written key itself, so only arithmetic keys can be visualized;
+        // the writes of other keys still show where they went
+        template<typename Key>
+        typename std::enable_if<std::is_arithmetic<Key>::value>::type emitWrite(std::size_t index, const Key& key) { emit(OperationType::WRITE, index, 0, static_cast<int>(key)); }
+
+        template<typename Key>
+        typename std::enable_if<!std::is_arithmetic<Key>::value>::type emitWrite(std::size_t index, const Key&) { emit(OperationType::WRITE, index); }
+
+        bool isCancelled() const { return operation_sink->isCancelled(); }
+    };
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "Sort/SortType.h"
+#include "Sort/SortOperation.h"
+#include "Sort/AccessPolicy.h"
+#include "Sort/InstrumentedArray.h"
+#include "Sort/Interface/IOperationSink.h"
+#include "Sort/Metrics/OperationCounters.h"
+#include "Sort/Metrics/MemoryModel.h"
+#include "Sort/RadixKey.h"
+#include "Sort/BubbleSort.h"
+#include "Sort/InsertionSort.h"
+#include "Sort/HeapSort.h"
+#include "Sort/SelectionSort.h"
+#include "Sort/MergeSort.h"
+#include "Sort/MultiwayMergeSort.h"
+#include "Sort/IntroSort.h"
+#include "Sort/ThreeWayQuickSort.h"
+#include "Sort/RadixSort.h"
+#include "Sort/TimSort.h"
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+namespace Sort
+{
+    // Sorts contiguous arrays of any key type in the order of Compare: unsigned and signed 32 and 64-bit
+    // integers, floats, doubles, pairs, or records ordered through an ExtractedKeyLess. Every Key / Compare
+    // pair is its own instantiation of the algorithms, so the compares and radix transforms inline as if
+    // written for that type. The radix sort needs a RadixOrder for the pair; without one it runs the
+    // (equally stable) merge sort. The external sort only takes int files, other keys get the multiway
+    // merge it is built on. Only arithmetic keys can be visualized, see VisualAccess.
+    // SortEngine adds the int-only parallel and external sorts on top of BasicSortEngine<int>.
+    template<typename Key, typename Compare = std::less<Key>>
+    class BasicSortEngine
+    {
+    private:
+        Interface::IOperationSink* operation_sink;
+        Metrics::OperationCounters<>* operation_counters;
+        Metrics::MemoryModel* memory_model;
+
+        Compare compare;
+        std::vector<Key> scratch;
+        unsigned heap_arity;
+
+        template<typename Policy>
+        void sortKeys(SortType sort_type, Key* keys, std::size_t size, Policy policy)
+        {
+            using Array = InstrumentedArray<Key, Policy, Compare>;
+
+            if (isUsingScratch(sort_type)) scratch.resize(size);
+            Array array(keys, size, scratch.data(), policy, compare);
+
+            switch (sort_type)
+            {
+            case SortType::BUBBLE_SORT:
+                BubbleSort<Array>().sort(array);
+                break;
+            case SortType::INSERTION_SORT:
+                InsertionSort<Array>().sort(array);
+                break;
+            case SortType::SELECTION_SORT:
+                SelectionSort<Array>().sort(array);
+                break;
+            case SortType::MERGE_SORT:
+                MergeSort<Array>().sort(array);
+                break;
+            case SortType::QUICK_SORT:
+                IntroSort<Array>().sort(array);
+                break;
+            case SortType::RADIX_SORT:
+                sortRadix(array, std::integral_constant<bool, RadixOrder<Key, Compare>::is_available>());
+                break;
+            case SortType::TIM_SORT:
+                TimSort<Array>().sort(array);
+                break;
+            case SortType::HEAP_SORT:
+                if (heap_arity == 8) HeapSort<Array, 8>().sort(array);
+                else if (heap_arity == 4) HeapSort<Array, 4>().sort(array);
+                else HeapSort<Array>().sort(array);
+                break;
+            case SortType::THREE_WAY_QUICK_SORT:
+                ThreeWayQuickSort<Array>().sort(array);
+                break;
+            case SortType::MULTIWAY_MERGE_SORT:
+            case SortType::EXTERNAL_MERGE_SORT:
+                MultiwayMergeSort<Array>().sort(array);
+                break;
+            }
+        }
+
+        template<typename Array>
+        static void sortRadix(Array& array, std::true_type) { RadixSort<Array>().sort(array); }
+
+        template<typename Array>
+        static void sortRadix(Array& array, std::false_type) { MergeSort<Array>().sort(array); }
+
+        static bool isUsingScratch(SortType sort_type)
+        {
+            return sort_type == SortType::MERGE_SORT || sort_type == SortType::RADIX_SORT || sort_type == SortType::TIM_SORT
+                || sort_type == SortType::MULTIWAY_MERGE_SORT || sort_type == SortType::EXTERNAL_MERGE_SORT;
+        }
+
+    public:
+        explicit BasicSortEngine(Compare compare = Compare()) : compare(compare)
+        {
+            operation_sink = nullptr;
+            operation_counters = nullptr;
+            memory_model = nullptr;
+            heap_arity = 4;
+        }
+
+        void setOperationSink(Interface::IOperationSink* sink) { operation_sink = sink; }
+
+        // Counts the accesses of later sorts, feeding the memory model too when one is given. A sink takes precedence.
+        void setOperationCounters(Metrics::OperationCounters<>* counters, Metrics::MemoryModel* memory_model = nullptr)
+        {
+            operation_counters = counters;
+            this->memory_model = memory_model;
+        }
+
+        // Children per node of the heap sort's heap: 2, 4 or 8, anything else falls back to 2
+        void setHeapArity(unsigned arity) { heap_arity = arity == 4 || arity == 8 ? arity : 2; }
+        unsigned getHeapArity() const { return heap_arity; }
+
+        void sort(SortType sort_type, Key* keys, std::size_t size)
+        {
+            if (size < 2) return;
+
+            if (operation_sink) sortKeys(sort_type, keys, size, VisualAccess(operation_sink));
+            else if (operation_counters) sortKeys(sort_type, keys, size, CountingAccess(operation_counters, memory_model));
+            else sortKeys(sort_type, keys, size, NativeAccess());
+        }
+    };
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include <cstddef>
+
+namespace Sort
+{
+    // Adjacent swaps with an early exit once a pass swaps nothing.
+    template<typename Array>
+    class BubbleSort
+    {
+    public:
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+
+            for (std::size_t i = 0; i < size - 1; i++)
+            {
+                if (keys.isCancelled()) return;
+                bool swapped = false;
+
+                for (std::size_t j = 0; j < size - 1 - i; j++)
+                {
+                    if (keys.isCancelled()) return;
+
+                    if (keys.less(j + 1, j))
+                    {
+                        keys.swap(j, j + 1);
+                        swapped = true;
+                    }
+                }
+
+                keys.highlight(size - 1 - i, HighlightType::PLACEMENT);
+
+                if (!swapped) break;
+            }
+        }
+    };
+}
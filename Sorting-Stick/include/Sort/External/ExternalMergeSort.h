@@ -0,0 +1,83 @@
+#pragma once
+#include "Sort/SortType.h"
+#include "Sort/SortOperation.h"
+#include "Sort/Interface/IOperationSink.h"
+#include "Sort/External/IoQueue.h"
+#include "Sort/External/RunFile.h"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Sort
+{
+    class SortEngine;
+
+    namespace External
+    {
+        // Sorts a file of native-endian 32-bit keys that does not have to fit in memory.
+        // The input is cut into runs of a third of the memory budget, each sorted by an in-memory engine while
+        // the last is written to a temporary file and the next is read. The runs are then merged at most
+        // max_fan_in at a time, in more than one pass if there are more, every run streaming through two
+        // blocks so the next block is read ahead while the current one is merged through a LoserTree and the
+        // output is written behind. With a sink attached, each run's sort is reported at the run's place in the input, every
+        // merged key as a read of its place in its run and the final output as writes, so the sticks show
+        // the runs forming and then draining into the result.
+        class ExternalMergeSort
+        {
+        private:
+            static const int number_of_buffers = 3; //the run being sorted, the one being written and the one being read
+
+            struct Run
+            {
+                std::string path;
+                std::size_t begin; //position of the run's first key in the input
+                std::size_t size;
+            };
+
+            // A run being merged, its next key standing at position
+            struct MergeInput
+            {
+                RunReader reader;
+                std::size_t position;
+            };
+
+            struct HeadLess;
+
+            std::size_t memory_budget;
+            std::size_t max_fan_in;
+            SortType run_sort_type;
+            SortEngine* run_engine;
+            IoQueue* io_queue;
+            Interface::IOperationSink* operation_sink;
+            std::string error;
+
+            bool formRuns(const std::string& input_path, const std::string& run_path, std::vector<Run>& runs);
+            void sortRun(int* keys, std::size_t size, std::size_t begin);
+            bool mergeRuns(const std::vector<Run>& runs, const std::string& output_path, bool is_output);
+
+            void report(OperationType type, std::size_t first, std::size_t second = 0, int value = 0);
+            bool isCancelled();
+            static void removeRuns(const std::vector<Run>& runs);
+
+        public:
+            ExternalMergeSort();
+            ~ExternalMergeSort();
+
+            ExternalMergeSort(const ExternalMergeSort&) = delete;
+            ExternalMergeSort& operator=(const ExternalMergeSort&) = delete;
+
+            // Bytes of keys held in memory at once, split between the run buffers or the merge blocks
+            void setMemoryBudget(std::size_t bytes);
+            void setMaxFanIn(std::size_t runs);
+            void setRunSortType(SortType sort_type);
+            void setNumberOfThreads(unsigned threads);
+            void setOperationSink(Interface::IOperationSink* sink);
+
+            // Temporary runs are written next to output_path and removed again. False when a file could not
+            // be read or written or the sink cancelled, with the reason in getError.
+            bool sort(const std::string& input_path, const std::string& output_path);
+            const std::string& getError() const;
+        };
+    }
+}
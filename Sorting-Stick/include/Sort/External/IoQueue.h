@@ -0,0 +1,38 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace Sort
+{
+    namespace External
+    {
+        // One background thread running file reads and writes in the order they were submitted, so the
+        // sort keeps working while the next blocks are read ahead and the finished ones written behind.
+        // A job returns how many keys it moved.
+        class IoQueue
+        {
+        private:
+            std::thread worker;
+            std::mutex mutex;
+            std::condition_variable job_available;
+            std::deque<std::packaged_task<std::size_t()>> jobs;
+            bool is_stopping;
+
+            void run();
+
+        public:
+            IoQueue();
+            ~IoQueue();
+
+            IoQueue(const IoQueue&) = delete;
+            IoQueue& operator=(const IoQueue&) = delete;
+
+            std::future<std::size_t> submit(std::function<std::size_t()> job);
+        };
+    }
+}
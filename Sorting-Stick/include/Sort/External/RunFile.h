@@ -0,0 +1,82 @@
+#pragma once
+#include "Sort/External/IoQueue.h"
+#include <cstddef>
+#include <fstream>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace Sort
+{
+    namespace External
+    {
+        // Streams the keys of a file through two blocks: while one is consumed, the next is read into the other.
+        class RunReader
+        {
+        private:
+            std::ifstream stream;
+            IoQueue* io_queue;
+            std::vector<int> blocks[2];
+            std::size_t block_keys;
+            int current_block;
+            std::size_t position;
+            std::size_t count;
+            std::future<std::size_t> pending_read;
+            bool is_read_failed; //set by the read job, only looked at once its future is ready
+            bool is_failed;
+
+            void readAhead();
+            void nextBlock();
+
+        public:
+            RunReader();
+            ~RunReader();
+
+            RunReader(const RunReader&) = delete;
+            RunReader& operator=(const RunReader&) = delete;
+
+            bool open(const std::string& path, std::size_t block_keys, IoQueue* io_queue);
+            void close();
+
+            bool isEmpty() const { return position == count; }
+            int peek() const { return blocks[current_block][position]; }
+            void pop() { if (++position == count) nextBlock(); }
+
+            // Whether a read failed, as opposed to the file simply ending
+            bool isFailed() const;
+        };
+
+        // Collects keys into one block while the other is being written out.
+        class RunWriter
+        {
+        private:
+            std::ofstream stream;
+            IoQueue* io_queue;
+            std::vector<int> blocks[2];
+            std::size_t block_keys;
+            int current_block;
+            std::size_t count;
+            std::future<std::size_t> pending_write;
+
+            void writeBehind();
+
+        public:
+            RunWriter();
+            ~RunWriter();
+
+            RunWriter(const RunWriter&) = delete;
+            RunWriter& operator=(const RunWriter&) = delete;
+
+            bool open(const std::string& path, std::size_t block_keys, IoQueue* io_queue);
+
+            // Writes out what is left, false when any write failed
+            bool close();
+
+            void push(int key)
+            {
+                blocks[current_block][count] = key;
+                if (++count == block_keys) writeBehind();
+            }
+        };
+    }
+}
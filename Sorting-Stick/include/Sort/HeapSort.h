@@ -0,0 +1,129 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Sort/InsertionSort.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace Sort
+{
+    // Max-heap sort over a heap with Arity children per node, binary by default.
+    // Sift-down is Floyd's bottom-up variant: the hole at the root is walked down to a leaf along the
+    // largest children, and the key that has to go in it climbs back the few levels it needs, instead of
+    // being compared on every level on the way down. In native runs the heap skips up to Arity - 1 leading
+    // keys so every group of siblings starts on an Arity-key boundary and never straddles a cache line;
+    // the smallest keys are moved into the skipped places first. sortRange is also the depth-limit
+    // fallback of the quick sort.
+    template<typename Array, unsigned Arity = 2>
+    class HeapSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+
+    private:
+        static std::size_t getFirstChild(std::size_t node) { return Arity * node + 1; }
+        static std::size_t getParent(std::size_t node) { return (node - 1) / Arity; }
+
+        // Puts key into the heap [base, base + heap_size) whose root's place is empty
+        static void siftDown(Array& keys, std::size_t base, std::size_t root, const Key& key, std::size_t heap_size)
+        {
+            std::size_t hole = root;
+            std::size_t child;
+
+            // Whole groups of siblings have a fixed count, so the compiler can unroll the search for the largest
+            while ((child = getFirstChild(hole)) + Arity <= heap_size)
+            {
+                std::size_t largest = child;
+                for (unsigned i = 1; i < Arity; i++) largest = keys.less(base + largest, base + child + i) ? child + i : largest;
+
+                keys.move(base + largest, base + hole);
+                hole = largest;
+            }
+
+            if (child < heap_size)
+            {
+                std::size_t largest = child;
+                for (std::size_t sibling = child + 1; sibling < heap_size; sibling++) largest = keys.less(base + largest, base + sibling) ? sibling : largest;
+
+                keys.move(base + largest, base + hole);
+                hole = largest;
+            }
+
+            // Keys taken from the end of the heap are small, so this rarely climbs more than a level or two
+            while (hole > root)
+            {
+                std::size_t parent = getParent(hole);
+                if (!keys.lessThanKey(base + parent, key, base + hole)) break;
+
+                keys.move(base + parent, base + hole);
+                hole = parent;
+            }
+
+            keys.write(base + hole, key);
+        }
+
+        // Keys to leave in front of the heap so its root sits just before an Arity-key boundary of memory,
+        // which puts every group of siblings on one. Only native runs have addresses worth aligning to.
+        static std::size_t getAlignmentSkip(Array& keys, std::size_t begin, std::size_t end)
+        {
+            if (!Array::PolicyType::is_native || end - begin <= Arity) return 0;
+
+            std::uintptr_t address = reinterpret_cast<std::uintptr_t>(keys.getKeys() + begin);
+            if (address % sizeof(Key) != 0) return 0;
+
+            std::size_t offset = static_cast<std::size_t>((address / sizeof(Key)) % Arity);
+            return (2 * Arity - 1 - offset) % Arity;
+        }
+
+        // Leaves the smallest skip keys of [begin, end) sorted in [begin, begin + skip)
+        static void selectSmallest(Array& keys, std::size_t begin, std::size_t skip, std::size_t end)
+        {
+            InsertionSort<Array>::sortRange(keys, begin, begin + skip);
+
+            std::size_t largest = begin + skip - 1;
+            for (std::size_t i = begin + skip; i < end; i++)
+            {
+                if (!keys.less(i, largest)) continue;
+
+                keys.swap(i, largest);
+                for (std::size_t j = largest; j > begin && keys.less(j, j - 1); j--) keys.swap(j, j - 1);
+            }
+        }
+
+    public:
+        // Sorts [begin, end)
+        static void sortRange(Array& keys, std::size_t begin, std::size_t end)
+        {
+            std::size_t skip = getAlignmentSkip(keys, begin, end);
+            if (skip > 0)
+            {
+                selectSmallest(keys, begin, skip, end);
+                begin += skip;
+            }
+
+            std::size_t heap_size = end - begin;
+            if (heap_size < 2) return;
+
+            keys.markPhase(PhaseType::HEAP, begin, end);
+
+            for (std::size_t root = getParent(heap_size - 1) + 1; root-- > 0;)
+            {
+                if (keys.isCancelled()) return;
+                siftDown(keys, begin, root, keys.read(begin + root), heap_size);
+            }
+
+            while (heap_size > 1)
+            {
+                if (keys.isCancelled()) return;
+
+                // The root goes to the end and the key it displaces is sifted down from the top
+                Key key = keys.read(begin + --heap_size);
+                keys.move(begin, begin + heap_size);
+                keys.highlight(begin + heap_size, HighlightType::PLACEMENT);
+                siftDown(keys, begin, 0, key, heap_size);
+            }
+        }
+
+        void sort(Array& keys) { sortRange(keys, 0, keys.getSize()); }
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Global/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Sort
+{
+    namespace Input
+    {
+        enum class DatasetType
+        {
+            INT32,
+            INT64,
+            FLOAT32,
+            FLOAT64,
+        };
+
+        // The DatasetType of each key type
+        template<typename Key>
+        struct DatasetKey;
+
+        template<> struct DatasetKey<std::int32_t> { static const DatasetType type = DatasetType::INT32; };
+        template<> struct DatasetKey<std::int64_t> { static const DatasetType type = DatasetType::INT64; };
+        template<> struct DatasetKey<float> { static const DatasetType type = DatasetType::FLOAT32; };
+        template<> struct DatasetKey<double> { static const DatasetType type = DatasetType::FLOAT64; };
+
+        // Keys of a binary file, memory mapped instead of read so samples of any size cost only the pages touched.
+        // A file is either raw little-endian keys of a type the caller names, or starts with a 16-byte header:
+        // "SKEY", version 1, the DatasetType, two zero bytes and the number of keys as a little-endian uint64.
+        class Dataset
+        {
+        private:
+            Global::MappedFile file;
+            DatasetType key_type;
+            const unsigned char* key_data;
+            std::size_t number_of_keys;
+            std::string error;
+
+            bool readHeader();
+
+        public:
+            static const std::size_t header_size = 16;
+
+            Dataset();
+
+            // raw_type is the key type of a file without a header
+            bool open(const std::string& path, DatasetType raw_type = DatasetType::INT32);
+            void close();
+
+            bool isOpen() const;
+            DatasetType getKeyType() const;
+            std::size_t getNumberOfKeys() const;
+            const std::string& getError() const;
+
+            // The mapped keys themselves, no copy made; nullptr unless Key is the file's key type
+            template<typename Key>
+            const Key* getKeys() const { return key_data && key_type == DatasetKey<Key>::type ? reinterpret_cast<const Key*>(key_data) : nullptr; }
+
+            // Copies keys [first, first + count) as int keys in the same order. int32 keys are copied as they are
+            // and float32 keys through their order-preserving bits; 64-bit keys do not fit, so they become their
+            // dense ranks within the copied keys, which compare the same way.
+            void copyKeys(std::size_t first, std::size_t count, int* keys) const;
+        };
+
+        std::size_t getDatasetKeySize(DatasetType key_type);
+        bool parseDatasetType(const char* name, DatasetType& key_type);
+    }
+}
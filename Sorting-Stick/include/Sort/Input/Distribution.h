@@ -0,0 +1,29 @@
+#pragma once
+
+namespace Sort
+{
+    namespace Input
+    {
+        enum class Distribution
+        {
+            PERMUTATION,   //uniform shuffle of 0..N-1
+            SORTED,
+            REVERSED,
+            NEARLY_SORTED, //every key at most k places from its sorted position
+            FEW_UNIQUE,
+            ORGAN_PIPE,    //ascending then descending
+            SAWTOOTH,
+            RUNS,          //sorted runs of length R
+            ZIPF,
+            RANDOM,        //uniform over every bit of the key type
+            DATASET,       //not generated, the keys come from a Dataset file
+        };
+
+        // The generated distributions, DATASET comes after them
+        const int number_of_distributions = 10;
+
+        const char* getDistributionName(Distribution distribution);
+        const char* getDistributionTitle(Distribution distribution);
+        bool parseDistribution(const char* name, Distribution& distribution);
+    }
+}
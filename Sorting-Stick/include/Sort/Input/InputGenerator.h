@@ -0,0 +1,50 @@
+#pragma once
+#include "Sort/Input/Distribution.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sort
+{
+    namespace Input
+    {
+        // Fills key arrays with reproducible inputs: the same seed, distribution and size always give the same keys,
+        // whatever was generated before. Apart from RANDOM every distribution stays within [0, N).
+        class InputGenerator
+        {
+        private:
+            std::uint64_t seed;
+
+            std::size_t nearly_sorted_distance;
+            std::size_t number_of_unique_keys;
+            std::size_t number_of_teeth;
+            std::size_t run_length;
+            double zipf_exponent;
+
+            std::vector<double> zipf_cumulative;
+
+            template<typename Key>
+            void generateKeys(Distribution distribution, Key* keys, std::size_t size);
+
+            void buildZipfTable(std::size_t number_of_ranks);
+
+        public:
+            InputGenerator(std::uint64_t seed = 0);
+
+            void setSeed(std::uint64_t seed);
+            std::uint64_t getSeed() const;
+
+            void setNearlySortedDistance(std::size_t distance);
+            void setNumberOfUniqueKeys(std::size_t number_of_keys);
+            void setNumberOfTeeth(std::size_t number_of_teeth);
+            void setRunLength(std::size_t run_length);
+            void setZipfExponent(double exponent);
+
+            void generate(Distribution distribution, int* keys, std::size_t size);
+            void generate(Distribution distribution, std::int64_t* keys, std::size_t size);
+
+            // Linearly rescales keys into [0, upper) when they fall outside it, keeping their order
+            static void fitToRange(int* keys, std::size_t size, int upper);
+        };
+    }
+}
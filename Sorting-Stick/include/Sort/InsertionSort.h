@@ -0,0 +1,42 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include <cstddef>
+
+namespace Sort
+{
+    // Holds each key aside and shifts the larger keys before it one place right.
+    // sortRange is also the small-range fallback of the quick sort.
+    template<typename Array>
+    class InsertionSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+
+        // Sorts [begin, end)
+        static void sortRange(Array& keys, std::size_t begin, std::size_t end)
+        {
+            for (std::size_t i = begin + 1; i < end; i++)
+            {
+                if (keys.isCancelled()) return;
+
+                Key key = keys.read(i);
+                keys.highlight(i, HighlightType::PROCESSING);
+
+                std::size_t hole = i;
+                while (hole > begin && keys.keyLessThan(key, hole, hole - 1))
+                {
+                    if (keys.isCancelled()) return;
+
+                    keys.move(hole - 1, hole);
+                    keys.highlight(hole, HighlightType::SELECTED);
+                    hole--;
+                }
+
+                keys.write(hole, key);
+                keys.highlight(hole, HighlightType::SELECTED);
+            }
+        }
+
+        void sort(Array& keys) { sortRange(keys, 0, keys.getSize()); }
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include "Sort/AccessPolicy.h"
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace Sort
+{
+    // The only way the sorting algorithms touch keys. Every load, store and comparison goes through
+    // one of these members, which performs it and tells the Policy about it, so one algorithm source
+    // runs natively, counted or visualized. Indices are positions in the keys array; the scratch
+    // buffer, when one is given, has the same size.
+    template<typename Key, typename Policy, typename Compare = std::less<Key>>
+    class InstrumentedArray
+    {
+    private:
+        Key* keys;
+        Key* scratch;
+        std::size_t size;
+
+        Policy policy;
+        Compare compare;
+
+    public:
+        using KeyType = Key;
+        using PolicyType = Policy;
+        using CompareType = Compare;
+
+        InstrumentedArray(Key* keys, std::size_t size, Key* scratch, Policy policy, Compare compare = Compare())
+            : keys(keys), scratch(scratch), size(size), policy(policy), compare(compare) { }
+
+        std::size_t getSize() const { return size; }
+        bool isCancelled() const { return policy.isCancelled(); }
+
+        // keys[a] < keys[b], both loaded
+        bool less(std::size_t a, std::size_t b)
+        {
+            policy.emit(OperationType::COMPARE, a, b, 2);
+            return compare(keys[a], keys[b]);
+        }
+
+        // keys[index] < key, where key is already held and shown at key_index
+        bool lessThanKey(std::size_t index, const Key& key, std::size_t key_index)
+        {
+            policy.emit(OperationType::COMPARE, index, key_index, 1);
+            return compare(keys[index], key);
+        }
+
+        // key < keys[index], where key is already held and shown at key_index
+        bool keyLessThan(const Key& key, std::size_t key_index, std::size_t index)
+        {
+            policy.emit(OperationType::COMPARE, index, key_index, 1);
+            return compare(key, keys[index]);
+        }
+
+        // Both keys already held, nothing is loaded; first and second only say where to show it
+        bool keysLess(const Key& a, const Key& b, std::size_t first, std::size_t second)
+        {
+            policy.emit(OperationType::COMPARE, first, second, 0);
+            return compare(a, b);
+        }
+
+        Key read(std::size_t index)
+        {
+            policy.emit(OperationType::READ, index);
+            return keys[index];
+        }
+
+        void write(std::size_t index, const Key& key)
+        {
+            keys[index] = key;
+            policy.emitWrite(index, key);
+        }
+
+        void swap(std::size_t a, std::size_t b)
+        {
+            std::swap(keys[a], keys[b]);
+            policy.emit(OperationType::SWAP, a, b);
+        }
+
+        void move(std::size_t from, std::size_t to)
+        {
+            keys[to] = std::move(keys[from]);
+            policy.emit(OperationType::MOVE, from, to);
+        }
+
+        void copyToScratch(std::size_t index, std::size_t scratch_index)
+        {
+            scratch[scratch_index] = keys[index];
+            policy.emit(OperationType::AUXILIARY_WRITE, index, scratch_index);
+        }
+
+        // Unreported loads. get is only for a key the very next reported operation loads again,
+        // getScratch for scratch reads, which the operation stream does not describe.
+        const Key& get(std::size_t index) const { return keys[index]; }
+        const Key& getScratch(std::size_t scratch_index) const { return scratch[scratch_index]; }
+
+        const Compare& getCompare() const { return compare; }
+
+        // The raw keys, for kernels that only run under a native Policy; nothing done through them is reported
+        Key* getKeys() { return keys; }
+
+        void highlight(std::size_t index, HighlightType highlight_type)
+        {
+            policy.emit(OperationType::HIGHLIGHT, index, 0, static_cast<int>(highlight_type));
+        }
+
+        // Highlights [begin, end); the loop itself is skipped unless the policy shows highlights
+        void highlightRange(std::size_t begin, std::size_t end, HighlightType highlight_type)
+        {
+            if (!Policy::is_visual) return;
+            for (std::size_t i = begin; i < end; i++) highlight(i, highlight_type);
+        }
+
+        void markPhase(PhaseType phase_type, std::size_t begin, std::size_t end)
+        {
+            policy.emit(OperationType::PHASE, begin, end, static_cast<int>(phase_type));
+        }
+    };
+}
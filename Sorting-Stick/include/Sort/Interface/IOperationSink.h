@@ -0,0 +1,17 @@
+#pragma once
+#include "Sort/SortOperation.h"
+
+namespace Sort
+{
+    namespace Interface
+    {
+        class IOperationSink
+        {
+        public:
+            virtual void onOperation(const SortOperation& operation) = 0;
+            virtual bool isCancelled() = 0;
+
+            virtual ~IOperationSink() { }
+        };
+    }
+}
@@ -0,0 +1,345 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Sort/InsertionSort.h"
+#include "Sort/HeapSort.h"
+#include "Sort/SortingNetwork.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace Sort
+{
+    // Introspective quicksort in the style of pdqsort.
+    // Pivots are the median of three, or a ninther above ninther_threshold keys. Partitioning is
+    // branchless: comparisons are gathered into small offset blocks and the misplaced keys moved in bulk.
+    // Small ranges fall back to insertion sort, or to a sorting network in native runs. A partition that leaves
+    // less than an eighth of the range on one side is a bad one: it swaps a few keys of both sides around to
+    // break the pattern that caused it, and after log N bad partitions the range is heapsorted, so the worst
+    // case stays O(N log N). Only the smaller side is recursed into, keeping the stack O(log N).
+    template<typename Array>
+    class IntroSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+        using Compare = typename Array::CompareType;
+
+    private:
+        static const std::size_t insertion_sort_cutoff = 24;
+        static const std::size_t ninther_threshold = 128;
+        static const std::size_t block_size = 64;
+
+        void introSort(Array& keys, std::size_t begin, std::size_t end, int bad_partitions_allowed, bool leftmost)
+        {
+            while (true)
+            {
+                if (keys.isCancelled()) return;
+
+                std::size_t size = end - begin;
+
+                // Native runs sort their small ranges in a sorting network, which nothing would show
+                if (Array::PolicyType::is_native && size <= SortingNetwork::getCutoff<Key, Compare>())
+                {
+                    SortingNetwork::sort(keys.getKeys() + begin, size, keys.getCompare());
+                    return;
+                }
+
+                if (size < insertion_sort_cutoff)
+                {
+                    InsertionSort<Array>::sortRange(keys, begin, end);
+                    keys.highlightRange(begin, end, HighlightType::PLACEMENT);
+                    return;
+                }
+
+                choosePivot(keys, begin, end);
+
+                // A key left of the range that is not less than the pivot equals it, and so does everything
+                // the left partition would produce; put all of them in place at once and only sort the rest
+                if (!leftmost && !keys.less(begin - 1, begin))
+                {
+                    begin = partitionLeft(keys, begin, end) + 1;
+                    continue;
+                }
+
+                std::size_t pivot = partitionRight(keys, begin, end);
+
+                if (isBadPartition(begin, pivot, pivot + 1, end))
+                {
+                    if (--bad_partitions_allowed == 0)
+                    {
+                        HeapSort<Array>::sortRange(keys, begin, end);
+                        keys.highlightRange(begin, end, HighlightType::PLACEMENT);
+                        return;
+                    }
+
+                    breakPatterns(keys, begin, pivot);
+                    breakPatterns(keys, pivot + 1, end);
+                }
+
+                if (pivot - begin < end - (pivot + 1))
+                {
+                    introSort(keys, begin, pivot, bad_partitions_allowed, leftmost);
+                    begin = pivot + 1;
+                    leftmost = false;
+                }
+                else
+                {
+                    introSort(keys, pivot + 1, end, bad_partitions_allowed, false);
+                    end = pivot;
+                }
+            }
+        }
+
+        static void sort2(Array& keys, std::size_t a, std::size_t b)
+        {
+            if (keys.less(b, a)) keys.swap(a, b);
+        }
+
+        static void sort3(Array& keys, std::size_t a, std::size_t b, std::size_t c)
+        {
+            sort2(keys, a, b);
+            sort2(keys, b, c);
+            sort2(keys, a, b);
+        }
+
+        // Moves num pairs of misplaced keys named by the two offset blocks across the partition
+        static void swapOffsets(Array& keys, std::size_t left_base, std::size_t right_base, const unsigned char* left_offsets, const unsigned char* right_offsets, std::size_t num, bool use_swaps)
+        {
+            if (use_swaps)
+            {
+                // Equal counts on both sides: a cycle would place the last key wrongly, plain swaps are needed
+                for (std::size_t i = 0; i < num; i++) keys.swap(left_base + left_offsets[i], right_base - right_offsets[i]);
+            }
+            else if (num > 0)
+            {
+                // One cyclic rotation moves every key once instead of three times per swap
+                std::size_t left = left_base + left_offsets[0];
+                std::size_t right = right_base - right_offsets[0];
+                Key temporary = keys.read(left);
+                keys.move(right, left);
+
+                for (std::size_t i = 1; i < num; i++)
+                {
+                    left = left_base + left_offsets[i];
+                    keys.move(left, right);
+                    right = right_base - right_offsets[i];
+                    keys.move(right, left);
+                }
+
+                keys.write(right, temporary);
+            }
+        }
+
+    public:
+        // The partitioning steps, shared with the three-way quick sort
+
+        // Partitions around the key at begin into [less than pivot) pivot [not less than pivot), returns the pivot's position
+        static std::size_t partitionRight(Array& keys, std::size_t begin, std::size_t end)
+        {
+            keys.markPhase(PhaseType::PARTITION, begin, end);
+
+            Key pivot = keys.read(begin);
+            std::size_t first = begin;
+            std::size_t last = end;
+
+            // The pivot choice guarantees a key not less than the pivot, so this stops inside the range
+            while (keys.lessThanKey(++first, pivot, begin));
+
+            if (first - 1 == begin) while (first < last && !keys.lessThanKey(--last, pivot, begin));
+            else while (!keys.lessThanKey(--last, pivot, begin));
+
+            if (first < last)
+            {
+                keys.swap(first, last);
+                first++;
+
+                unsigned char left_offsets[block_size];
+                unsigned char right_offsets[block_size];
+                std::size_t left_base = first;
+                std::size_t right_base = last;
+                std::size_t left_count = 0;
+                std::size_t right_count = 0;
+                std::size_t left_start = 0;
+                std::size_t right_start = 0;
+
+                while (first < last)
+                {
+                    if (keys.isCancelled()) return first - 1;
+
+                    // Refill whichever blocks ran empty, splitting the unknown keys between them when both did
+                    std::size_t unknown = last - first;
+                    std::size_t left_split = left_count == 0 ? (right_count == 0 ? unknown / 2 : unknown) : 0;
+                    std::size_t right_split = right_count == 0 ? (unknown - left_split) : 0;
+
+                    // The compare result is added to the count instead of branched on
+                    std::size_t left_fill = std::min(left_split, block_size);
+                    for (std::size_t i = 0; i < left_fill; i++)
+                    {
+                        left_offsets[left_count] = static_cast<unsigned char>(i);
+                        left_count += !keys.lessThanKey(first, pivot, begin);
+                        first++;
+                    }
+
+                    std::size_t right_fill = std::min(right_split, block_size);
+                    for (std::size_t i = 0; i < right_fill;)
+                    {
+                        right_offsets[right_count] = static_cast<unsigned char>(++i);
+                        right_count += keys.lessThanKey(--last, pivot, begin);
+                    }
+
+                    std::size_t num = std::min(left_count, right_count);
+                    swapOffsets(keys, left_base, right_base, left_offsets + left_start, right_offsets + right_start, num, left_count == right_count);
+
+                    left_count -= num;
+                    right_count -= num;
+                    left_start += num;
+                    right_start += num;
+
+                    if (left_count == 0)
+                    {
+                        left_start = 0;
+                        left_base = first;
+                    }
+
+                    if (right_count == 0)
+                    {
+                        right_start = 0;
+                        right_base = last;
+                    }
+                }
+
+                // At most one block still has misplaced keys; move them to the boundary
+                if (left_count)
+                {
+                    const unsigned char* offsets = left_offsets + left_start;
+                    while (left_count--) keys.swap(left_base + offsets[left_count], --last);
+                    first = last;
+                }
+
+                if (right_count)
+                {
+                    const unsigned char* offsets = right_offsets + right_start;
+                    while (right_count--) keys.swap(right_base - offsets[right_count], first++);
+                }
+            }
+
+            std::size_t pivot_position = first - 1;
+            keys.move(pivot_position, begin);
+            keys.write(pivot_position, pivot);
+
+            keys.highlight(begin, HighlightType::NORMAL);
+            keys.highlight(pivot_position, HighlightType::PLACEMENT);
+            return pivot_position;
+        }
+
+        // Partitions around the key at begin into [not greater than pivot) pivot [greater than pivot), returns the pivot's position.
+        // Used when the pivot equals a key before the range, so the left side is all equal keys.
+        static std::size_t partitionLeft(Array& keys, std::size_t begin, std::size_t end)
+        {
+            keys.markPhase(PhaseType::PARTITION, begin, end);
+
+            Key pivot = keys.read(begin);
+            std::size_t first = begin;
+            std::size_t last = end;
+
+            while (keys.keyLessThan(pivot, begin, --last));
+
+            if (last + 1 == end) while (first < last && !keys.keyLessThan(pivot, begin, ++first));
+            else while (!keys.keyLessThan(pivot, begin, ++first));
+
+            while (first < last)
+            {
+                if (keys.isCancelled()) return last;
+
+                keys.swap(first, last);
+                while (keys.keyLessThan(pivot, begin, --last));
+                while (!keys.keyLessThan(pivot, begin, ++first));
+            }
+
+            keys.move(last, begin);
+            keys.write(last, pivot);
+
+            keys.highlight(begin, HighlightType::NORMAL);
+            keys.highlightRange(begin, last + 1, HighlightType::PLACEMENT);
+            return last;
+        }
+
+        // Leaves the pivot at begin, with a key not less than it somewhere after it
+        static void choosePivot(Array& keys, std::size_t begin, std::size_t end)
+        {
+            std::size_t size = end - begin;
+            std::size_t half = size / 2;
+
+            if (size > ninther_threshold)
+            {
+                sort3(keys, begin, begin + half, end - 1);
+                sort3(keys, begin + 1, begin + (half - 1), end - 2);
+                sort3(keys, begin + 2, begin + (half + 1), end - 3);
+                sort3(keys, begin + (half - 1), begin + half, begin + (half + 1));
+                keys.swap(begin, begin + half);
+            }
+            else
+            {
+                sort3(keys, begin + half, begin, end - 1);
+            }
+
+            keys.highlight(begin, HighlightType::SELECTED);
+        }
+
+        // After choosePivot: whether the sample the pivot was the median of held it more than once, the cheap
+        // sign of a range full of keys equal to it
+        static bool isPivotRepeated(Array& keys, std::size_t begin, std::size_t end)
+        {
+            std::size_t size = end - begin;
+            std::size_t half = size / 2;
+
+            // The sample's other keys are ordered around the pivot, so it is repeated if it equals either neighbour
+            if (size > ninther_threshold) return !keys.less(begin + (half - 1), begin) || !keys.less(begin, begin + (half + 1));
+            return !keys.less(begin + half, begin) || !keys.less(begin, end - 1);
+        }
+
+        // Whether a partition of [begin, end) into [begin, left_end) and [right_begin, end) left less than an eighth on one side
+        static bool isBadPartition(std::size_t begin, std::size_t left_end, std::size_t right_begin, std::size_t end)
+        {
+            std::size_t size = end - begin;
+            return left_end - begin < size / 8 || end - right_begin < size / 8;
+        }
+
+        // Swaps the keys at both ends of the side [begin, end) of a bad partition with keys a quarter of the way in,
+        // which moves the next pivot candidates off whatever pattern put them at the edge
+        static void breakPatterns(Array& keys, std::size_t begin, std::size_t end)
+        {
+            std::size_t size = end - begin;
+            if (size < insertion_sort_cutoff) return;
+
+            std::size_t quarter = size / 4;
+            keys.swap(begin, begin + quarter);
+            keys.swap(end - 1, end - quarter);
+
+            if (size > ninther_threshold)
+            {
+                keys.swap(begin + 1, begin + (quarter + 1));
+                keys.swap(begin + 2, begin + (quarter + 2));
+                keys.swap(end - 2, end - (quarter + 1));
+                keys.swap(end - 3, end - (quarter + 2));
+            }
+        }
+
+        // Bad partitions tolerated before a range is heapsorted
+        static int getBadPartitionLimit(std::size_t size)
+        {
+            int log = 0;
+            while (size >>= 1) log++;
+            return log;
+        }
+
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+            introSort(keys, 0, size, getBadPartitionLimit(size), true);
+        }
+    };
+
+    // std::min takes block_size by reference, which needs a definition outside the class
+    template<typename Array>
+    const std::size_t IntroSort<Array>::block_size;
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <utility>
+
+namespace Sort
+{
+    // Orders records by a key an extractor pulls out of them, e.g. [](const Order& order) { return order.price; }.
+    // The radix sort reads the same extractor, so it buckets the extracted key's bits rather than the record's.
+    template<typename Extractor>
+    class ExtractedKeyLess
+    {
+    private:
+        Extractor extractor;
+
+    public:
+        ExtractedKeyLess(Extractor extractor = Extractor()) : extractor(std::move(extractor)) { }
+
+        template<typename Record>
+        bool operator()(const Record& a, const Record& b) const { return extractor(a) < extractor(b); }
+
+        const Extractor& getExtractor() const { return extractor; }
+    };
+
+    template<typename Extractor>
+    ExtractedKeyLess<Extractor> makeKeyLess(Extractor extractor) { return ExtractedKeyLess<Extractor>(std::move(extractor)); }
+}
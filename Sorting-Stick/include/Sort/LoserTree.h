@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Sort
+{
+    // Tournament tree over k sorted sources that yields their keys in order, for merging k runs in one pass.
+    // Every inner node keeps the loser of the match played there and the overall winner sits on top, so
+    // after the winner's source moves on only the matches on its path to the root are replayed: log2(k)
+    // comparisons per key. The tree only holds source numbers and asks less(a, b) whether source a's
+    // current key is below source b's, so the keys can live in arrays, file blocks or anywhere else. A source
+    // that runs out is marked exhausted and loses every match from then on, no sentinel key needed.
+    // Equal keys go to the lower source first, so merging runs in order is stable.
+    template<typename Less>
+    class LoserTree
+    {
+    private:
+        Less less;
+        std::size_t number_of_sources;
+        std::size_t number_of_leaves; //number_of_sources rounded up to a power of two
+
+        std::vector<std::size_t> nodes; //nodes[0] is the winner, nodes[1, number_of_leaves) the losers
+        std::vector<std::size_t> winners;
+        std::vector<unsigned char> is_exhausted; //one per leaf, the leaves past the last source never play
+
+        // Whether source a wins its match against source b
+        bool beats(std::size_t a, std::size_t b)
+        {
+            if (is_exhausted[b]) return true;
+            if (is_exhausted[a]) return false;
+            return a < b ? !less(b, a) : less(a, b);
+        }
+
+    public:
+        explicit LoserTree(Less less = Less()) : less(less), number_of_sources(0), number_of_leaves(1) { }
+
+        // Starts over with number_of_sources sources, none of them exhausted; build before use
+        void reset(std::size_t number_of_sources)
+        {
+            this->number_of_sources = number_of_sources;
+
+            number_of_leaves = 1;
+            while (number_of_leaves < number_of_sources) number_of_leaves *= 2;
+
+            nodes.assign(number_of_leaves, 0);
+            winners.resize(2 * number_of_leaves);
+            is_exhausted.assign(number_of_leaves, 1);
+            for (std::size_t source = 0; source < number_of_sources; source++) is_exhausted[source] = 0;
+        }
+
+        // For sources that are empty from the start, before build
+        void markExhausted(std::size_t source) { is_exhausted[source] = 1; }
+
+        // Plays every match once, the current key of every live source has to be readable through less
+        void build()
+        {
+            for (std::size_t leaf = 0; leaf < number_of_leaves; leaf++) winners[number_of_leaves + leaf] = leaf;
+
+            for (std::size_t node = number_of_leaves - 1; node > 0; node--)
+            {
+                std::size_t left = winners[2 * node];
+                std::size_t right = winners[2 * node + 1];
+                bool is_left_winner = beats(left, right);
+
+                winners[node] = is_left_winner ? left : right;
+                nodes[node] = is_left_winner ? right : left;
+            }
+
+            nodes[0] = number_of_leaves > 1 ? winners[1] : 0;
+        }
+
+        bool isEmpty() const { return is_exhausted[nodes[0]] != 0; }
+
+        // The source holding the smallest current key
+        std::size_t top() const { return nodes[0]; }
+
+        // The top source has moved on to its next key
+        void replay()
+        {
+            std::size_t winner = nodes[0];
+
+            for (std::size_t node = (number_of_leaves + winner) / 2; node > 0; node /= 2)
+            {
+                if (beats(nodes[node], winner)) std::swap(nodes[node], winner);
+            }
+
+            nodes[0] = winner;
+        }
+
+        // The top source has no keys left
+        void pop()
+        {
+            is_exhausted[nodes[0]] = 1;
+            replay();
+        }
+
+        std::size_t getNumberOfSources() const { return number_of_sources; }
+        Less& getLess() { return less; }
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include <cstddef>
+
+namespace Sort
+{
+    // Top-down merge sort that copies each range to the scratch buffer and merges it back in place,
+    // so every merge shows up in the keys. Native runs use ParallelMergeSort instead.
+    template<typename Array>
+    class MergeSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+
+    private:
+        void sortRange(Array& keys, std::size_t left, std::size_t right)
+        {
+            if (right - left < 2 || keys.isCancelled()) return;
+
+            std::size_t mid = left + (right - left) / 2;
+            sortRange(keys, left, mid);
+            sortRange(keys, mid, right);
+            merge(keys, left, mid, right);
+        }
+
+        void merge(Array& keys, std::size_t left, std::size_t mid, std::size_t right)
+        {
+            if (keys.isCancelled()) return;
+            keys.markPhase(PhaseType::MERGE, left, right);
+
+            for (std::size_t index = left; index < right; index++)
+            {
+                keys.copyToScratch(index, index);
+                keys.highlight(index, HighlightType::TEMPORARY);
+            }
+
+            std::size_t i = left;
+            std::size_t j = mid;
+            std::size_t k = left;
+
+            // Merge back into the keys, taking from the left run on ties to stay stable
+            while (i < mid && j < right)
+            {
+                const Key& left_key = keys.getScratch(i);
+                const Key& right_key = keys.getScratch(j);
+
+                if (!keys.keysLess(right_key, left_key, k, k)) keys.write(k, keys.getScratch(i++));
+                else keys.write(k, keys.getScratch(j++));
+
+                keys.highlight(k++, HighlightType::PROCESSING);
+            }
+
+            while (i < mid)
+            {
+                keys.write(k, keys.getScratch(i++));
+                keys.highlight(k++, HighlightType::PROCESSING);
+            }
+
+            while (j < right)
+            {
+                keys.write(k, keys.getScratch(j++));
+                keys.highlight(k++, HighlightType::PROCESSING);
+            }
+        }
+
+    public:
+        void sort(Array& keys) { sortRange(keys, 0, keys.getSize()); }
+    };
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Sort
+{
+    namespace Metrics
+    {
+        enum class CacheLevel
+        {
+            L1,
+            L2,
+            LLC,
+        };
+
+        const int number_of_cache_levels = 3;
+
+        struct CacheLevelConfig
+        {
+            std::size_t capacity; //bytes
+            std::size_t line_size; //bytes
+            std::size_t associativity; //ways per set
+        };
+
+        struct CacheConfig
+        {
+            CacheLevelConfig levels[number_of_cache_levels];
+        };
+
+        struct CacheStatistics
+        {
+            std::uint64_t accesses = 0;
+            std::uint64_t misses[number_of_cache_levels] = {};
+
+            std::uint64_t getMisses(CacheLevel level) const { return misses[static_cast<int>(level)]; }
+
+            // Share of all accesses that missed this level, so the LLC rate is the share that went to memory
+            double getMissRate(CacheLevel level) const { return accesses ? static_cast<double>(getMisses(level)) / accesses : 0.0; }
+        };
+
+        // Set-associative L1 / L2 / LLC model with LRU replacement. An access walks down the levels until one
+        // hits and fills every level that missed; levels are neither inclusive nor exclusive beyond that.
+        class CacheSimulator
+        {
+        private:
+            struct LevelState
+            {
+                CacheLevelConfig config;
+                std::size_t number_of_sets;
+
+                std::vector<std::uint64_t> lines; //line address + 1 per way, 0 marks an empty way
+                std::vector<std::uint64_t> last_used;
+            };
+
+            LevelState levels[number_of_cache_levels];
+            std::uint64_t clock;
+            CacheStatistics statistics;
+
+            bool accessLevel(LevelState& level, std::uint64_t address);
+
+        public:
+            CacheSimulator(const CacheConfig& cache_config = getDefaultConfig());
+
+            void configure(const CacheConfig& cache_config);
+            void reset();
+
+            void access(std::uint64_t address);
+
+            const CacheStatistics& getStatistics() const;
+
+            // 32 KiB 8-way L1, 1 MiB 16-way L2 and 16 MiB 16-way LLC with 64 byte lines
+            static CacheConfig getDefaultConfig();
+        };
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace Sort
+{
+    namespace Metrics
+    {
+        enum class CounterType
+        {
+            COMPARISONS,
+            READS,
+            WRITES,
+            SWAPS,
+            AUXILIARY_WRITES,
+        };
+
+        const int number_of_counter_types = 5;
+
+        struct CounterValues
+        {
+            std::uint64_t counts[number_of_counter_types] = {};
+
+            std::uint64_t get(CounterType counter_type) const { return counts[static_cast<int>(counter_type)]; }
+            std::uint64_t getArrayAccess() const { return get(CounterType::READS) + get(CounterType::WRITES); }
+        };
+
+        // Operation counters split into per-thread shards that never share a cache line.
+        // A thread only ever writes its own shard, so adding is a plain relaxed load and store with no contention;
+        // readers sum every shard, which is race-free from any thread at any time.
+        class CounterRegistry
+        {
+        private:
+            struct Shard
+            {
+                std::atomic<std::uint64_t> counts[number_of_counter_types];
+                Shard* next;
+                char padding[64]; //heap blocks are not cache-line aligned before C++17, so keep the next shard a full line away
+
+                Shard();
+            };
+
+            std::atomic<Shard*> shards;
+            std::uint64_t registry_id; //identifies this registry in the per-thread shard caches, renewed on reset
+
+            Shard* getLocalShard();
+            Shard* acquireShard();
+            void releaseShards();
+
+        public:
+            CounterRegistry();
+            ~CounterRegistry();
+
+            CounterRegistry(const CounterRegistry&) = delete;
+            CounterRegistry& operator=(const CounterRegistry&) = delete;
+
+            void add(CounterType counter_type, std::uint64_t amount = 1)
+            {
+                std::atomic<std::uint64_t>& count = getLocalShard()->counts[static_cast<int>(counter_type)];
+                count.store(count.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+            }
+
+            std::uint64_t get(CounterType counter_type) const;
+            CounterValues read() const;
+
+            // Must not run while any thread is adding to or reading from the registry
+            void reset();
+        };
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "Sort/Metrics/CacheSimulator.h"
+#include "Sort/SortOperation.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Sort
+{
+    namespace Metrics
+    {
+        // Replays a sort's operation stream as memory addresses through a CacheSimulator.
+        // The keys and the scratch buffer are laid out as two page-aligned arrays; key copies the
+        // stream does not name, such as merges reading back from scratch, are not seen, so the misses are estimates.
+        class MemoryModel
+        {
+        private:
+            static const std::uint64_t page_size = 4096;
+
+            CacheSimulator cache_simulator;
+            std::size_t element_size;
+            std::uint64_t scratch_base;
+
+            std::uint64_t getKeyAddress(std::size_t index) const { return index * element_size; }
+            std::uint64_t getScratchAddress(std::size_t index) const { return scratch_base + index * element_size; }
+
+        public:
+            MemoryModel(const CacheConfig& cache_config = CacheSimulator::getDefaultConfig());
+
+            void configure(const CacheConfig& cache_config);
+
+            // Starts a new sort over size keys of element_size bytes, clearing the caches
+            void reset(std::size_t size, std::size_t element_size = sizeof(int));
+
+            void access(const SortOperation& operation);
+
+            const CacheStatistics& getStatistics() const;
+        };
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "Sort/Metrics/CounterRegistry.h"
+#include "Sort/SortOperation.h"
+
+namespace Sort
+{
+    namespace Metrics
+    {
+        // Counting policies. ShardedCounting keeps race-free per-thread counters,
+        // NoCounting has empty inline members so every counting call compiles away.
+        class ShardedCounting
+        {
+        private:
+            CounterRegistry counter_registry;
+
+        public:
+            static const bool is_enabled = true;
+
+            void add(CounterType counter_type, std::uint64_t amount) { counter_registry.add(counter_type, amount); }
+            CounterValues read() const { return counter_registry.read(); }
+            void reset() { counter_registry.reset(); }
+        };
+
+        class NoCounting
+        {
+        public:
+            static const bool is_enabled = false;
+
+            void add(CounterType, std::uint64_t) { }
+            CounterValues read() const { return CounterValues(); }
+            void reset() { }
+        };
+
+        // Benchmark builds define SORT_DISABLE_COUNTERS to strip counting out of every default counter
+#ifdef SORT_DISABLE_COUNTERS
+        using DefaultCounting = NoCounting;
+#else
+        using DefaultCounting = ShardedCounting;
+#endif
+
+        // Turns the sort operation stream into comparison / read / write / swap / auxiliary write counts.
+        template<typename CountingPolicy = DefaultCounting>
+        class OperationCounters
+        {
+        private:
+            CountingPolicy counting_policy;
+
+        public:
+            static const bool is_enabled = CountingPolicy::is_enabled;
+
+            void count(const SortOperation& operation)
+            {
+                switch (operation.type)
+                {
+                case OperationType::COMPARE:
+                    counting_policy.add(CounterType::COMPARISONS, 1);
+                    counting_policy.add(CounterType::READS, static_cast<std::uint64_t>(operation.value));
+                    break;
+                case OperationType::SWAP:
+                    counting_policy.add(CounterType::SWAPS, 1);
+                    counting_policy.add(CounterType::READS, 2);
+                    counting_policy.add(CounterType::WRITES, 2);
+                    break;
+                case OperationType::MOVE:
+                    counting_policy.add(CounterType::READS, 1);
+                    counting_policy.add(CounterType::WRITES, 1);
+                    break;
+                case OperationType::WRITE:
+                    counting_policy.add(CounterType::WRITES, 1);
+                    break;
+                case OperationType::READ:
+                    counting_policy.add(CounterType::READS, 1);
+                    break;
+                case OperationType::AUXILIARY_WRITE:
+                    counting_policy.add(CounterType::READS, 1);
+                    counting_policy.add(CounterType::AUXILIARY_WRITES, 1);
+                    break;
+                case OperationType::HIGHLIGHT:
+                case OperationType::PHASE:
+                    break;
+                }
+            }
+
+            CounterValues read() const { return counting_policy.read(); }
+            void reset() { counting_policy.reset(); }
+        };
+    }
+}
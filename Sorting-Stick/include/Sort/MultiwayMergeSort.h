@@ -0,0 +1,104 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Sort/InsertionSort.h"
+#include "Sort/LoserTree.h"
+#include "Sort/SortingNetwork.h"
+#include <cstddef>
+#include <type_traits>
+
+namespace Sort
+{
+    // Top-down merge sort that cuts every range into FanIn parts and merges them back in a single pass
+    // through a LoserTree. The keys go through the scratch buffer log_FanIn(N) times instead of log2(N)
+    // for the same log2(N) comparisons per key. As in MergeSort each range is copied to the scratch buffer
+    // and merged back into the keys, so every merge shows up in the keys. Stable.
+    template<typename Array, unsigned FanIn = 8>
+    class MultiwayMergeSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+        using Compare = typename Array::CompareType;
+
+    private:
+        static const std::size_t insertion_sort_cutoff = 16;
+
+        // Compares the scratch keys at the heads of two parts, shown where the keys came from
+        struct HeadLess
+        {
+            Array* keys;
+            const std::size_t* heads;
+
+            bool operator()(std::size_t a, std::size_t b) const { return keys->keysLess(keys->getScratch(heads[a]), keys->getScratch(heads[b]), heads[a], heads[b]); }
+        };
+
+        std::size_t heads[FanIn];
+        LoserTree<HeadLess> loser_tree;
+
+        void sortRange(Array& keys, std::size_t begin, std::size_t end)
+        {
+            if (keys.isCancelled()) return;
+
+            std::size_t size = end - begin;
+
+            // Only integers, whose equal keys cannot be told apart (-0.0 and 0.0 can); the network does not keep them in order
+            if (Array::PolicyType::is_native && IsVectorizedNetwork<Key, Compare>::value && std::is_integral<Key>::value && size <= SortingNetwork::max_size)
+            {
+                SortingNetwork::sort(keys.getKeys() + begin, size, keys.getCompare());
+                return;
+            }
+
+            if (size <= insertion_sort_cutoff)
+            {
+                InsertionSort<Array>::sortRange(keys, begin, end);
+                return;
+            }
+
+            std::size_t bounds[FanIn + 1];
+            for (unsigned part = 0; part <= FanIn; part++) bounds[part] = begin + size * part / FanIn;
+
+            for (unsigned part = 0; part < FanIn; part++) sortRange(keys, bounds[part], bounds[part + 1]);
+            merge(keys, bounds);
+        }
+
+        void merge(Array& keys, const std::size_t* bounds)
+        {
+            if (keys.isCancelled()) return;
+
+            std::size_t begin = bounds[0];
+            std::size_t end = bounds[FanIn];
+            keys.markPhase(PhaseType::MERGE, begin, end);
+
+            for (std::size_t index = begin; index < end; index++)
+            {
+                keys.copyToScratch(index, index);
+                keys.highlight(index, HighlightType::TEMPORARY);
+            }
+
+            loser_tree.reset(FanIn);
+            for (unsigned part = 0; part < FanIn; part++)
+            {
+                heads[part] = bounds[part];
+                if (bounds[part] == bounds[part + 1]) loser_tree.markExhausted(part);
+            }
+            loser_tree.build();
+
+            for (std::size_t k = begin; !loser_tree.isEmpty(); k++)
+            {
+                std::size_t part = loser_tree.top();
+                keys.write(k, keys.getScratch(heads[part]));
+                keys.highlight(k, HighlightType::PROCESSING);
+
+                if (++heads[part] == bounds[part + 1]) loser_tree.pop();
+                else loser_tree.replay();
+            }
+        }
+
+    public:
+        void sort(Array& keys)
+        {
+            loser_tree.getLess().keys = &keys;
+            loser_tree.getLess().heads = heads;
+            sortRange(keys, 0, keys.getSize());
+        }
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+namespace Sort
+{
+    // Stable task-parallel merge sort for native (unrecorded) runs.
+    // The leaves are sorted by a sorting network or insertion sort. One scratch buffer is allocated per sort and the recursion ping-pongs between it and the keys,
+    // so every level merges straight into the buffer the level above reads from. Subproblems are forked
+    // onto threads, and large merges are split with merge path co-ranking so the top merges run in parallel too.
+    class ParallelMergeSort
+    {
+    private:
+        const std::size_t insertion_sort_cutoff = 32;
+        const std::size_t base_case_size; //the larger of the insertion sort and sorting network cutoffs
+        const std::size_t parallel_sort_cutoff = 1 << 15;
+        const std::size_t parallel_merge_cutoff = 1 << 16;
+
+        std::vector<int> scratch;
+        unsigned number_of_threads;
+
+        void sortRange(int* keys, int* buffer, std::size_t size, bool result_in_buffer, unsigned threads);
+        void sortBaseCase(int* keys, std::size_t size);
+        void insertionSort(int* keys, std::size_t size);
+
+        void merge(const int* left, std::size_t left_size, const int* right, std::size_t right_size, int* output, unsigned threads);
+        void mergeSequential(const int* left, const int* left_end, const int* right, const int* right_end, int* output);
+        std::size_t coRank(std::size_t k, const int* left, std::size_t left_size, const int* right, std::size_t right_size);
+
+    public:
+        ParallelMergeSort();
+
+        // 0 picks std::thread::hardware_concurrency()
+        void setNumberOfThreads(unsigned threads);
+        void sort(int* keys, std::size_t size);
+    };
+}
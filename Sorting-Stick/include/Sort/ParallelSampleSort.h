@@ -0,0 +1,136 @@
+#pragma once
+#include "Global/Barrier.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace Sort
+{
+    // In-place parallel samplesort in the style of IPS4o, for native (unrecorded) runs.
+    // Each step draws splitters from a sample into a branchless search tree. Every thread classifies its
+    // stripe of the range into one small buffer per bucket, flushing full blocks back over keys it has
+    // already read; the blocks are then permuted into their buckets through per-bucket read and write
+    // pointers, and the partial blocks at the bucket edges are filled from the buffers. Extra memory is a
+    // fixed number of blocks per thread, whatever N. Ranges larger than one thread's share are split by all
+    // threads together, the buckets below that are sorted whole by single threads, down to IntroSort.
+    class ParallelSampleSort
+    {
+    private:
+        static const std::size_t block_size = 256;
+        static const unsigned max_log_leaves = 7;
+        static const std::size_t max_leaves = std::size_t(1) << max_log_leaves;
+        static const std::size_t max_buckets = 2 * max_leaves; //every leaf can get an equality bucket
+        static const std::size_t base_case_size = 4096;
+        static const std::size_t parallel_sort_cutoff = 1 << 18;
+        static const int max_recursion_depth = 16; //only reached by pathological samples, IntroSort takes over
+
+        struct ThreadContext;
+
+        // Maps a key to its bucket by descending a complete tree of the splitters without branching.
+        // With equality buckets, keys equal to a splitter get an odd bucket of their own that needs no sorting.
+        struct Classifier
+        {
+            int tree[max_leaves];      //Eytzinger order, the root at 1
+            int splitters[max_leaves]; //sorted, the last one is the largest int
+            unsigned log_leaves;
+            bool use_equal_buckets;
+
+            std::size_t getNumberOfBuckets() const;
+            bool isEqualBucket(std::size_t bucket) const;
+            std::size_t classify(int key) const;
+        };
+
+        // One partitioning step, shared by the threads working on it. Positions are offsets from begin.
+        struct Partition
+        {
+            int* begin;
+            std::size_t size;
+            unsigned number_of_threads;
+
+            Classifier classifier;
+            std::vector<ThreadContext*> contexts;
+
+            std::vector<std::size_t> stripe_begins;
+            std::vector<std::size_t> stripe_full_blocks;
+            std::vector<std::size_t> blocks_to_move_before; //full blocks past full_end in the earlier stripes
+            std::vector<std::size_t> empty_blocks_before;   //empty blocks before full_end in the earlier stripes
+            std::size_t full_end;
+
+            std::size_t bucket_begins[max_buckets + 1];
+
+            // Blocks in [write, read) are full and not yet in place; a block is taken from below read and
+            // delivered to write. Each pair is only touched under its bucket's mutex.
+            std::size_t write_pointers[max_buckets];
+            std::size_t read_pointers[max_buckets];
+            std::mutex bucket_mutexes[max_buckets];
+
+            // The keys a bucket's last block spilled past the bucket's end, one block per bucket
+            std::vector<int> overflow;
+
+            Partition();
+        };
+
+        struct ThreadContext
+        {
+            std::vector<int> buffers; //one block per bucket
+            std::size_t buffer_sizes[max_buckets];
+            std::size_t bucket_sizes[max_buckets];
+            std::vector<int> swap_buffers;
+            std::mt19937_64 random_engine;
+            std::unique_ptr<Partition> partition; //for the ranges this thread sorts alone
+
+            ThreadContext();
+        };
+
+        struct Task
+        {
+            int* begin;
+            std::size_t size;
+            int depth_limit;
+        };
+
+        unsigned number_of_threads;
+        std::vector<std::unique_ptr<ThreadContext>> contexts;
+
+        // Team state, used while a sort runs on more than one thread
+        std::unique_ptr<Partition> shared_partition;
+        Global::Barrier* barrier;
+        unsigned team_size;
+        std::vector<Task> big_tasks;
+        std::vector<Task> small_tasks;
+        std::atomic<std::size_t> next_small_task;
+        std::size_t big_task_size;
+        int shared_depth_limit;
+        bool is_partitioning_done;
+
+        void sortSequential(int* begin, std::size_t size, ThreadContext& context, int depth_limit);
+        void sortBaseCase(int* begin, std::size_t size);
+
+        void runTeam(unsigned thread);
+        void prepareBigTask();
+        void queueBuckets();
+
+        void preparePartition(Partition& partition, int* begin, std::size_t size, unsigned threads);
+        void buildClassifier(Partition& partition, ThreadContext& context);
+        void classifyStripe(Partition& partition, ThreadContext& context, unsigned thread);
+        void computeBuckets(Partition& partition);
+        void moveFullBlocks(Partition& partition, unsigned thread);
+        void permuteBlocks(Partition& partition, ThreadContext& context, unsigned thread);
+        bool takeBlock(Partition& partition, std::size_t bucket, int* block);
+        bool placeBlock(Partition& partition, std::size_t bucket, const int* block, int* displaced_block);
+        void saveOverflow(Partition& partition, unsigned thread);
+        static std::size_t getOverflowBegin(const Partition& partition, std::size_t bucket);
+        void fillBucketEdges(Partition& partition, unsigned thread);
+
+    public:
+        ParallelSampleSort();
+        ~ParallelSampleSort();
+
+        // 0 picks std::thread::hardware_concurrency()
+        void setNumberOfThreads(unsigned threads);
+        void sort(int* keys, std::size_t size);
+    };
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "Sort/KeyExtractor.h"
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace Sort
+{
+    // Order-preserving transforms from a key to an unsigned integer of the same width,
+    // so the radix sort can bucket raw bits: a < b exactly when toBits(a) < toBits(b).
+    template<typename Key>
+    struct RadixKey;
+
+    template<>
+    struct RadixKey<std::uint32_t>
+    {
+        using Bits = std::uint32_t;
+        static Bits toBits(std::uint32_t key) { return key; }
+    };
+
+    template<>
+    struct RadixKey<std::uint64_t>
+    {
+        using Bits = std::uint64_t;
+        static Bits toBits(std::uint64_t key) { return key; }
+    };
+
+    // Two's complement: flipping the sign bit moves negatives below positives
+    template<>
+    struct RadixKey<std::int32_t>
+    {
+        using Bits = std::uint32_t;
+        static Bits toBits(std::int32_t key) { return static_cast<Bits>(key) ^ 0x80000000u; }
+    };
+
+    template<>
+    struct RadixKey<std::int64_t>
+    {
+        using Bits = std::uint64_t;
+        static Bits toBits(std::int64_t key) { return static_cast<Bits>(key) ^ 0x8000000000000000ull; }
+    };
+
+    // IEEE 754: positives get the sign bit set, negatives get every bit flipped so larger magnitudes sort lower.
+    // -0.0 lands just below +0.0 and NaNs end up past the infinities of their sign.
+    template<>
+    struct RadixKey<float>
+    {
+        using Bits = std::uint32_t;
+        static Bits toBits(float key)
+        {
+            Bits bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return bits ^ ((bits >> 31) ? 0xFFFFFFFFu : 0x80000000u);
+        }
+    };
+
+    template<>
+    struct RadixKey<double>
+    {
+        using Bits = std::uint64_t;
+        static Bits toBits(double key)
+        {
+            Bits bits;
+            std::memcpy(&bits, &key, sizeof(bits));
+            return bits ^ ((bits >> 63) ? 0xFFFFFFFFFFFFFFFFull : 0x8000000000000000ull);
+        }
+    };
+
+    // Whether RadixKey has a transform for Key
+    template<typename Key, typename = void>
+    struct HasRadixKey : std::false_type { };
+
+    template<typename Key>
+    struct HasRadixKey<Key, decltype(void(sizeof(typename RadixKey<Key>::Bits)))> : std::true_type { };
+
+    // Pairs sort by first, then second: the first key's bits above the second's, when both fit in 64 bits
+    template<typename First, typename Second, bool = HasRadixKey<First>::value && HasRadixKey<Second>::value>
+    struct IsPairFitting : std::false_type { };
+
+    template<typename First, typename Second>
+    struct IsPairFitting<First, Second, true>
+        : std::integral_constant<bool, sizeof(typename RadixKey<First>::Bits) + sizeof(typename RadixKey<Second>::Bits) <= sizeof(std::uint64_t)> { };
+
+    template<typename First, typename Second, bool = IsPairFitting<First, Second>::value>
+    struct PairRadixKey { };
+
+    template<typename First, typename Second>
+    struct PairRadixKey<First, Second, true>
+    {
+        using Bits = std::uint64_t;
+
+        static Bits toBits(const std::pair<First, Second>& key)
+        {
+            return (static_cast<Bits>(RadixKey<First>::toBits(key.first)) << (8 * sizeof(typename RadixKey<Second>::Bits))) | RadixKey<Second>::toBits(key.second);
+        }
+    };
+
+    template<typename First, typename Second>
+    struct RadixKey<std::pair<First, Second>> : PairRadixKey<First, Second> { };
+
+    // The bits a radix sort buckets keys by under a comparator: a key's own bits for std::less, the flipped
+    // bits for std::greater and the extracted key's bits for ExtractedKeyLess. Other comparators have none.
+    template<typename Key, typename Compare, typename = void>
+    struct RadixOrder { static const bool is_available = false; };
+
+    template<typename Key>
+    struct RadixOrder<Key, std::less<Key>, decltype(void(sizeof(typename RadixKey<Key>::Bits)))>
+    {
+        static const bool is_available = true;
+        using Bits = typename RadixKey<Key>::Bits;
+
+        static Bits toBits(const std::less<Key>&, const Key& key) { return RadixKey<Key>::toBits(key); }
+    };
+
+    template<typename Key>
+    struct RadixOrder<Key, std::greater<Key>, decltype(void(sizeof(typename RadixKey<Key>::Bits)))>
+    {
+        static const bool is_available = true;
+        using Bits = typename RadixKey<Key>::Bits;
+
+        static Bits toBits(const std::greater<Key>&, const Key& key) { return static_cast<Bits>(~RadixKey<Key>::toBits(key)); }
+    };
+
+    template<typename Extractor, typename Record>
+    using ExtractedKey = typename std::decay<decltype(std::declval<const Extractor&>()(std::declval<const Record&>()))>::type;
+
+    template<typename Record, typename Extractor>
+    struct RadixOrder<Record, ExtractedKeyLess<Extractor>, decltype(void(sizeof(typename RadixKey<ExtractedKey<Extractor, Record>>::Bits)))>
+    {
+        static const bool is_available = true;
+        using Bits = typename RadixKey<ExtractedKey<Extractor, Record>>::Bits;
+
+        static Bits toBits(const ExtractedKeyLess<Extractor>& compare, const Record& record) { return RadixKey<ExtractedKey<Extractor, Record>>::toBits(compare.getExtractor()(record)); }
+    };
+}
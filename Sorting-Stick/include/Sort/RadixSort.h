@@ -0,0 +1,138 @@
+#pragma once
+#include "Sort/RadixKey.h"
+#include "Sort/SortOperation.h"
+#include "Sort/SortingNetwork.h"
+#include "Sort/InsertionSort.h"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Sort
+{
+    // LSD radix sort over the order-preserving bits of a key under the array's comparator (see RadixOrder),
+    // RadixBits bits per pass.
+    // All digit histograms are built in a single read of the input, passes whose digit is the same
+    // for every key are skipped, and the scatter ping-pongs between the keys and the array's scratch buffer.
+    template<typename Array, unsigned RadixBits = 8>
+    class RadixSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+        using Compare = typename Array::CompareType;
+
+    private:
+        using Order = RadixOrder<Key, Compare>;
+        using Bits = typename Order::Bits;
+
+        static const unsigned number_of_buckets = 1u << RadixBits;
+        static const unsigned number_of_passes = (sizeof(Bits) * 8 + RadixBits - 1) / RadixBits;
+        static const Bits digit_mask = static_cast<Bits>(number_of_buckets - 1);
+
+        std::vector<std::size_t> histograms;
+
+    public:
+        static std::size_t getDigit(const Compare& compare, const Key& key, unsigned pass)
+        {
+            return static_cast<std::size_t>((Order::toBits(compare, key) >> (pass * RadixBits)) & digit_mask);
+        }
+
+        // A pass is a no-op when one bucket holds every key
+        static bool isPassNeeded(const std::size_t* histogram, std::size_t size)
+        {
+            for (unsigned bucket = 0; bucket < number_of_buckets; bucket++)
+            {
+                if (histogram[bucket] == size) return false;
+                if (histogram[bucket] != 0) return true;
+            }
+            return true;
+        }
+
+        // Turns counts into starting offsets
+        static void toOffsets(std::size_t* histogram)
+        {
+            std::size_t offset = 0;
+            for (unsigned bucket = 0; bucket < number_of_buckets; bucket++)
+            {
+                std::size_t count = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += count;
+            }
+        }
+
+        static unsigned getNumberOfPasses() { return number_of_passes; }
+        static unsigned getNumberOfBuckets() { return number_of_buckets; }
+
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+
+            // A native input this short is cheaper to sort in a network than to histogram. The network does not keep
+            // equal keys in order, so only integers, whose equal keys cannot be told apart (-0.0 and 0.0 can);
+            // other keys go by insertion instead.
+            if (Array::PolicyType::is_native && size <= SortingNetwork::getCutoff<Key, Compare>())
+            {
+                if (IsVectorizedNetwork<Key, Compare>::value && std::is_integral<Key>::value) SortingNetwork::sort(keys.getKeys(), size, keys.getCompare());
+                else InsertionSort<Array>::sortRange(keys, 0, size);
+                return;
+            }
+
+            // One read per key fills the histograms of every digit at once
+            histograms.assign(number_of_passes * number_of_buckets, 0);
+            for (std::size_t i = 0; i < size; i++)
+            {
+                Bits bits = Order::toBits(keys.getCompare(), keys.read(i));
+                for (unsigned pass = 0; pass < number_of_passes; pass++)
+                    histograms[pass * number_of_buckets + ((bits >> (pass * RadixBits)) & digit_mask)]++;
+            }
+
+            bool is_in_scratch = false;
+
+            for (unsigned pass = 0; pass < number_of_passes; pass++)
+            {
+                if (keys.isCancelled()) return;
+
+                std::size_t* histogram = histograms.data() + pass * number_of_buckets;
+                if (!isPassNeeded(histogram, size)) continue;
+
+                toOffsets(histogram);
+                keys.markPhase(PhaseType::PASS, 0, size);
+
+                if (!is_in_scratch)
+                {
+                    for (std::size_t i = 0; i < size; i++) //scattering the keys into their buckets in the scratch buffer
+                    {
+                        keys.copyToScratch(i, histogram[getDigit(keys.getCompare(), keys.get(i), pass)]++);
+                        keys.highlight(i, HighlightType::TEMPORARY);
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < size; i++) //and back again on the next pass
+                    {
+                        const Key& key = keys.getScratch(i);
+                        std::size_t target = histogram[getDigit(keys.getCompare(), key, pass)]++;
+
+                        keys.write(target, key);
+                        keys.highlight(target, HighlightType::PLACEMENT);
+                    }
+                }
+
+                is_in_scratch = !is_in_scratch;
+            }
+
+            // An odd number of passes leaves the result in the scratch buffer
+            if (is_in_scratch)
+            {
+                for (std::size_t i = 0; i < size; i++)
+                {
+                    if (keys.isCancelled()) return;
+
+                    keys.write(i, keys.getScratch(i));
+                    keys.highlight(i, HighlightType::PLACEMENT);
+                }
+            }
+        }
+    };
+}
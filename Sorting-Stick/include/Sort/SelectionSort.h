@@ -0,0 +1,43 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include <cstddef>
+
+namespace Sort
+{
+    // Swaps the smallest remaining key into place, one swap per position.
+    template<typename Array>
+    class SelectionSort
+    {
+    public:
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+
+            for (std::size_t i = 0; i < size - 1; i++)
+            {
+                if (keys.isCancelled()) return;
+
+                std::size_t min_index = i;
+                keys.highlight(i, HighlightType::SELECTED);
+
+                for (std::size_t j = i + 1; j < size; j++)
+                {
+                    if (keys.isCancelled()) return;
+
+                    if (keys.less(j, min_index))
+                    {
+                        if (min_index != i) keys.highlight(min_index, HighlightType::NORMAL);
+
+                        min_index = j;
+                        keys.highlight(min_index, HighlightType::TEMPORARY);
+                    }
+                }
+
+                keys.swap(i, min_index);
+                if (min_index != i) keys.highlight(min_index, HighlightType::NORMAL);
+                keys.highlight(i, HighlightType::PLACEMENT);
+            }
+        }
+    };
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Sort/SortType.h"
+#include "Sort/SortOperation.h"
+#include "Sort/Interface/IOperationSink.h"
+#include "Sort/Metrics/OperationCounters.h"
+#include "Sort/Metrics/MemoryModel.h"
+#include "Sort/ParallelMergeSort.h"
+#include "Sort/ParallelSampleSort.h"
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace Sort
+{
+    namespace External { class ExternalMergeSort; }
+
+    template<typename Key, typename Compare>
+    class BasicSortEngine;
+
+    // Sorts plain contiguous int arrays. Each algorithm is written once against InstrumentedArray and
+    // compiled three times: natively when nothing is attached, counting into operation counters, or
+    // reporting every compare / swap / write to a sink so a visualizer can replay it. Those run in
+    // BasicSortEngine<int>; natively the merge and quick sorts use every core, and the external sort goes
+    // through files. Other key types use BasicSortEngine directly.
+    class SortEngine
+    {
+    private:
+        Interface::IOperationSink* operation_sink;
+        Metrics::OperationCounters<>* operation_counters;
+        Metrics::MemoryModel* memory_model;
+
+        BasicSortEngine<int, std::less<int>>* key_sort_engine;
+        ParallelMergeSort parallel_merge_sort;
+        ParallelSampleSort parallel_sample_sort;
+        unsigned number_of_threads;
+
+        // Made on first use, it sorts its runs with an engine of its own
+        External::ExternalMergeSort* external_merge_sort;
+        std::size_t external_memory_budget;
+        std::string external_file_path;
+
+        void sortExternal(int* keys, std::size_t size);
+
+    public:
+        SortEngine();
+        ~SortEngine();
+
+        void setOperationSink(Interface::IOperationSink* sink);
+
+        // Counts the accesses of later sorts, feeding the memory model too when one is given. A sink takes precedence.
+        void setOperationCounters(Metrics::OperationCounters<>* counters, Metrics::MemoryModel* memory_model = nullptr);
+
+        // Threads of the native merge and quick sorts, 0 picks std::thread::hardware_concurrency()
+        void setNumberOfThreads(unsigned threads);
+
+        // Children per node of the heap sort's heap: 2, 4 or 8, anything else falls back to 2
+        void setHeapArity(unsigned arity);
+        unsigned getHeapArity() const;
+
+        // The external merge sort writes arrays to file_path + ".input" and sorts them through files next to it,
+        // holding memory_budget bytes of keys at a time
+        void setExternalSortOptions(std::size_t memory_budget, const std::string& file_path);
+
+        void sort(SortType sort_type, int* keys, std::size_t size);
+    };
+}
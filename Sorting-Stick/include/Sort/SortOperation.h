@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+
+namespace Sort
+{
+    enum class OperationType
+    {
+        COMPARE,         // first, second : indices whose keys were compared, value : how many were loaded (2, 1 = first only, 0)
+        SWAP,            // first, second : indices whose keys were exchanged
+        MOVE,            // first -> second : key copied from one index to another
+        WRITE,           // first = value : key written from outside the array (scratch buffer, register)
+        READ,            // first : key read into scratch storage
+        HIGHLIGHT,       // first : index, value : HighlightType
+        PHASE,           // [first, second) : range, value : PhaseType
+        AUXILIARY_WRITE, // first -> second : key copied from an index to the same-sized scratch buffer
+    };
+
+    enum class HighlightType
+    {
+        NORMAL,
+        PROCESSING,
+        PLACEMENT,
+        SELECTED,
+        TEMPORARY,
+        LESS,    // below the pivot of the last partition
+        GREATER, // above it
+    };
+
+    enum class PhaseType
+    {
+        PASS,
+        MERGE,
+        PARTITION,
+        RUN,
+        HEAP, // [first, second) is laid out as a heap, its root at first
+    };
+
+    struct SortOperation
+    {
+        OperationType type;
+        std::size_t first;
+        std::size_t second;
+        int value;
+    };
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+namespace Sort
+{
+    enum class SortType
+    {
+        BUBBLE_SORT,
+        INSERTION_SORT,
+        SELECTION_SORT,
+        MERGE_SORT,
+        QUICK_SORT,
+        RADIX_SORT,
+        TIM_SORT,
+        HEAP_SORT,
+        THREE_WAY_QUICK_SORT,
+        MULTIWAY_MERGE_SORT,
+        EXTERNAL_MERGE_SORT,
+    };
+}
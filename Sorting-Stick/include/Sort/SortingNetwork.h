@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#if defined(__AVX512F__)
+#define SORT_NETWORK_AVX512
+#elif defined(__AVX2__)
+#define SORT_NETWORK_AVX2
+#elif defined(__SSE4_1__) || defined(__AVX__)
+#define SORT_NETWORK_SSE4_1
+#endif
+
+namespace Sort
+{
+    // Whether SortingNetwork::sort keeps these keys in vector registers for this compiler target
+    template<typename Key, typename Compare>
+    struct IsVectorizedNetwork { static const bool value = false; };
+
+#if defined(SORT_NETWORK_AVX512) || defined(SORT_NETWORK_AVX2) || defined(SORT_NETWORK_SSE4_1)
+    template<> struct IsVectorizedNetwork<std::int32_t, std::less<std::int32_t>> { static const bool value = true; };
+    template<> struct IsVectorizedNetwork<float, std::less<float>> { static const bool value = true; };
+#endif
+
+#if defined(SORT_NETWORK_AVX512) || defined(SORT_NETWORK_AVX2)
+    template<> struct IsVectorizedNetwork<std::int64_t, std::less<std::int64_t>> { static const bool value = true; };
+#endif
+
+    // Branch-free sorting networks for the small ranges at the bottom of the native sorts.
+    // int32, float and int64 keys under std::less are sorted in vector registers: every register is sorted
+    // across its lanes by a bitonic network, then the registers are bitonic-merged in pairs. The widest of
+    // AVX-512, AVX2 and SSE4.1 the compiler targets is used (/arch:AVX2, -mavx2, ...). Other keys, compares
+    // and targets get Batcher's odd-even merge network on scalar compare-exchanges.
+    class SortingNetwork
+    {
+    public:
+        static const std::size_t max_size = 64;
+        static const std::size_t scalar_cutoff = 16;
+
+        // The largest range worth sorting here rather than by insertion: all of max_size in registers,
+        // while on scalar compare-exchanges the network only keeps up with insertion sort on short ranges
+        template<typename Key, typename Compare>
+        static std::size_t getCutoff() { return IsVectorizedNetwork<Key, Compare>::value ? max_size : scalar_cutoff; }
+
+        // Sorts [keys, keys + size), size at most max_size
+        template<typename Key, typename Compare>
+        static void sort(Key* keys, std::size_t size, const Compare& compare)
+        {
+            // Comparators reaching past the end are left out, as if the missing keys were larger than any other
+            for (std::size_t p = 1; p < size; p *= 2)
+            {
+                for (std::size_t k = p; k > 0; k /= 2)
+                {
+                    for (std::size_t j = k % p; j + k < size; j += 2 * k)
+                    {
+                        for (std::size_t i = 0; i < k && i + j + k < size; i++)
+                        {
+                            if (((i + j) ^ (i + j + k)) < 2 * p) compareExchange(keys[i + j], keys[i + j + k], compare);
+                        }
+                    }
+                }
+            }
+        }
+
+        static void sort(std::int32_t* keys, std::size_t size, const std::less<std::int32_t>& compare);
+        static void sort(float* keys, std::size_t size, const std::less<float>& compare);
+        static void sort(std::int64_t* keys, std::size_t size, const std::less<std::int64_t>& compare);
+
+    private:
+        // Selects instead of branching, which compilers turn into conditional moves
+        template<typename Key, typename Compare>
+        static void compareExchange(Key& a, Key& b, const Compare& compare)
+        {
+            bool is_swapped = compare(b, a);
+            Key low = is_swapped ? b : a;
+            Key high = is_swapped ? a : b;
+            a = low;
+            b = high;
+        }
+    };
+}
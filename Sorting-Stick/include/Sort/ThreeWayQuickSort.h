@@ -0,0 +1,108 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Sort/InsertionSort.h"
+#include "Sort/HeapSort.h"
+#include "Sort/IntroSort.h"
+#include "Sort/SortingNetwork.h"
+#include <algorithm>
+#include <cstddef>
+
+namespace Sort
+{
+    // IntroSort that takes the whole band of keys equal to the pivot out of the recursion as soon as the
+    // pivot's sample shows it repeated, for keys with few distinct values: after the block partition, one
+    // more pass gathers the keys equal to the pivot at the front of the right side. IntroSort only sets such
+    // a band aside one level later, and only if the right side's pivot happens to be equal too. N keys with
+    // D distinct values cost O(N log D) comparisons. Pivots, small ranges and bad partitions are handled by
+    // IntroSort's own code, so keys without duplicates cost what they cost there.
+    template<typename Array>
+    class ThreeWayQuickSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+        using Compare = typename Array::CompareType;
+
+    private:
+        using Partitioner = IntroSort<Array>;
+
+        static const std::size_t insertion_sort_cutoff = 24;
+
+        void quickSort(Array& keys, std::size_t begin, std::size_t end, int bad_partitions_allowed, bool leftmost)
+        {
+            while (true)
+            {
+                if (keys.isCancelled()) return;
+
+                std::size_t size = end - begin;
+
+                if (Array::PolicyType::is_native && size <= SortingNetwork::getCutoff<Key, Compare>())
+                {
+                    SortingNetwork::sort(keys.getKeys() + begin, size, keys.getCompare());
+                    return;
+                }
+
+                if (size < insertion_sort_cutoff)
+                {
+                    InsertionSort<Array>::sortRange(keys, begin, end);
+                    keys.highlightRange(begin, end, HighlightType::PLACEMENT);
+                    return;
+                }
+
+                Partitioner::choosePivot(keys, begin, end);
+
+                // A pivot equal to the key left of the range is the last of its band, as in IntroSort
+                if (!leftmost && !keys.less(begin - 1, begin))
+                {
+                    begin = Partitioner::partitionLeft(keys, begin, end) + 1;
+                    keys.highlightRange(begin, end, HighlightType::GREATER);
+                    continue;
+                }
+
+                // The right side holds no key less than the pivot, so partitioning it around the pivot again leaves the band in front
+                bool is_repeated = Partitioner::isPivotRepeated(keys, begin, end);
+                std::size_t equal_begin = Partitioner::partitionRight(keys, begin, end);
+                std::size_t equal_end = equal_begin + 1;
+                if (is_repeated && equal_end < end) equal_end = Partitioner::partitionLeft(keys, equal_begin, end) + 1;
+
+                // The three regions in their own colours; only a sink sees them
+                keys.highlightRange(begin, equal_begin, HighlightType::LESS);
+                keys.highlightRange(equal_begin, equal_end, HighlightType::PLACEMENT);
+                keys.highlightRange(equal_end, end, HighlightType::GREATER);
+
+                // Bad when the larger side keeps more than seven eighths: a wide equal band is progress however small both sides are
+                if (std::max(equal_begin - begin, end - equal_end) > size - size / 8)
+                {
+                    if (--bad_partitions_allowed == 0)
+                    {
+                        HeapSort<Array>::sortRange(keys, begin, end);
+                        keys.highlightRange(begin, end, HighlightType::PLACEMENT);
+                        return;
+                    }
+
+                    Partitioner::breakPatterns(keys, begin, equal_begin);
+                    Partitioner::breakPatterns(keys, equal_end, end);
+                }
+
+                if (equal_begin - begin < end - equal_end)
+                {
+                    quickSort(keys, begin, equal_begin, bad_partitions_allowed, leftmost);
+                    begin = equal_end;
+                    leftmost = false;
+                }
+                else
+                {
+                    quickSort(keys, equal_end, end, bad_partitions_allowed, false);
+                    end = equal_begin;
+                }
+            }
+        }
+
+    public:
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+            quickSort(keys, 0, size, Partitioner::getBadPartitionLimit(size), true);
+        }
+    };
+}
@@ -0,0 +1,364 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace Sort
+{
+    // Natural merge sort in the style of Timsort.
+    // The keys are cut into the runs already present (descending runs are reversed), short runs are
+    // extended to a minimum length with binary insertion sort, and runs are merged off a stack whose
+    // lengths grow like Fibonacci numbers, so merges stay balanced. Merges copy the shorter run to the
+    // scratch buffer and switch to galloping when one run keeps winning. Sorted and reversed input is a single run: O(N).
+    template<typename Array>
+    class TimSort
+    {
+    public:
+        using Key = typename Array::KeyType;
+
+    private:
+        static const std::size_t min_merge = 32;
+        static const std::size_t initial_min_gallop = 7;
+
+        struct Run
+        {
+            std::size_t begin;
+            std::size_t length;
+        };
+
+        std::vector<Run> run_stack;
+        std::size_t min_gallop;
+
+        // Returns the end of the run starting at begin, leaving it ascending. Only strictly descending runs
+        // are reversed, so equal keys never change order.
+        static std::size_t findRun(Array& keys, std::size_t begin, std::size_t end)
+        {
+            std::size_t run_end = begin + 1;
+            if (run_end == end) return end;
+
+            if (keys.less(run_end++, begin))
+            {
+                while (run_end < end && keys.less(run_end, run_end - 1)) run_end++;
+                for (std::size_t low = begin, high = run_end - 1; low < high; low++, high--) keys.swap(low, high);
+            }
+            else
+            {
+                while (run_end < end && !keys.less(run_end, run_end - 1)) run_end++;
+            }
+
+            return run_end;
+        }
+
+        // Sorts [begin, end) given [begin, start) is sorted, binary searching each key's place after the equal ones
+        static void binaryInsertionSort(Array& keys, std::size_t begin, std::size_t end, std::size_t start)
+        {
+            for (std::size_t i = start; i < end; i++)
+            {
+                Key key = keys.read(i);
+                keys.highlight(i, HighlightType::SELECTED);
+
+                std::size_t low = begin;
+                std::size_t high = i;
+                while (low < high)
+                {
+                    std::size_t mid = low + (high - low) / 2;
+                    if (keys.keyLessThan(key, i, mid)) high = mid;
+                    else low = mid + 1;
+                }
+
+                for (std::size_t j = i; j > low; j--) keys.move(j - 1, j);
+                keys.write(low, key);
+                keys.highlight(low, HighlightType::NORMAL);
+            }
+        }
+
+        // First offset in [0, length) whose key is_past, or length; is_past must never turn false again along the run.
+        // Steps outward from hint by 1, 3, 7, ... and binary searches the last step, so a key that belongs
+        // k places from hint costs O(log k) comparisons.
+        template<typename Predicate>
+        static std::size_t gallop(std::size_t base, std::size_t length, std::size_t hint, Predicate is_past)
+        {
+            std::size_t low;
+            std::size_t high;
+            std::size_t step = 1;
+
+            if (is_past(base + hint))
+            {
+                high = hint;
+                while (step <= hint && is_past(base + hint - step))
+                {
+                    high = hint - step;
+                    step = step * 2 + 1;
+                }
+                low = step <= hint ? hint - step + 1 : 0;
+            }
+            else
+            {
+                low = hint + 1;
+                while (hint + step < length && !is_past(base + hint + step))
+                {
+                    low = hint + step + 1;
+                    step = step * 2 + 1;
+                }
+                high = std::min(hint + step, length);
+            }
+
+            while (low < high)
+            {
+                std::size_t mid = low + (high - low) / 2;
+                if (is_past(base + mid)) high = mid;
+                else low = mid + 1;
+            }
+
+            return low;
+        }
+
+        static std::size_t getMinRun(std::size_t size)
+        {
+            // Chosen so size / min_run is a power of two or just below one, which keeps the final merges balanced
+            std::size_t low_bits = 0;
+            while (size >= min_merge)
+            {
+                low_bits |= size & 1;
+                size >>= 1;
+            }
+            return size + low_bits;
+        }
+
+        // Merges until every run is longer than the next two above it combined, checking one level deeper
+        // than the original Timsort did so the invariant holds for the whole stack
+        void mergeCollapse(Array& keys)
+        {
+            while (run_stack.size() > 1)
+            {
+                std::size_t n = run_stack.size() - 2;
+
+                if ((n > 0 && run_stack[n - 1].length <= run_stack[n].length + run_stack[n + 1].length) ||
+                    (n > 1 && run_stack[n - 2].length <= run_stack[n - 1].length + run_stack[n].length))
+                {
+                    if (run_stack[n - 1].length < run_stack[n + 1].length) n--;
+                }
+                else if (run_stack[n].length > run_stack[n + 1].length)
+                {
+                    break;
+                }
+
+                mergeAt(keys, n);
+            }
+        }
+
+        void mergeForceCollapse(Array& keys)
+        {
+            while (run_stack.size() > 1)
+            {
+                std::size_t n = run_stack.size() - 2;
+                if (n > 0 && run_stack[n - 1].length < run_stack[n + 1].length) n--;
+                mergeAt(keys, n);
+            }
+        }
+
+        // Merges runs n and n + 1 of the stack
+        void mergeAt(Array& keys, std::size_t n)
+        {
+            std::size_t begin = run_stack[n].begin;
+            std::size_t mid = run_stack[n + 1].begin;
+            std::size_t end = mid + run_stack[n + 1].length;
+
+            run_stack[n].length = end - begin;
+            run_stack.erase(run_stack.begin() + (n + 1));
+
+            if (keys.isCancelled()) return;
+            keys.markPhase(PhaseType::MERGE, begin, end);
+
+            // Keys of the left run not greater than the right run's first are already in place
+            Key first_right = keys.read(mid);
+            begin += gallop(begin, mid - begin, 0, [&](std::size_t i) { return keys.keyLessThan(first_right, mid, i); });
+            if (begin == mid) return;
+
+            // And so are keys of the right run not less than the left run's last
+            Key last_left = keys.read(mid - 1);
+            end = mid + gallop(mid, end - mid, end - mid - 1, [&](std::size_t i) { return !keys.lessThanKey(i, last_left, mid - 1); });
+            if (end == mid) return;
+
+            if (mid - begin <= end - mid) mergeLow(keys, begin, mid, end);
+            else mergeHigh(keys, begin, mid, end);
+        }
+
+        // Left run is the shorter: it goes to scratch and the merge fills the keys from the front
+        void mergeLow(Array& keys, std::size_t begin, std::size_t mid, std::size_t end)
+        {
+            for (std::size_t i = begin; i < mid; i++)
+            {
+                keys.copyToScratch(i, i);
+                keys.highlight(i, HighlightType::TEMPORARY);
+            }
+
+            std::size_t left = begin;
+            std::size_t right = mid;
+            std::size_t target = begin;
+
+            while (left < mid && right < end)
+            {
+                std::size_t left_wins = 0;
+                std::size_t right_wins = 0;
+
+                // One key at a time until a run wins min_gallop times in a row, taking from the left on ties
+                do
+                {
+                    if (keys.lessThanKey(right, keys.getScratch(left), left))
+                    {
+                        keys.move(right++, target);
+                        right_wins++;
+                        left_wins = 0;
+                    }
+                    else
+                    {
+                        keys.write(target, keys.getScratch(left++));
+                        left_wins++;
+                        right_wins = 0;
+                    }
+                    keys.highlight(target++, HighlightType::PROCESSING);
+                } while (left < mid && right < end && std::max(left_wins, right_wins) < min_gallop);
+
+                if (left == mid || right == end) break;
+
+                // Then search for where each run's next key goes and copy everything before it in one go
+                do
+                {
+                    left_wins = gallop(left, mid - left, 0, [&](std::size_t i) { return keys.lessThanKey(right, keys.getScratch(i), i); });
+                    for (std::size_t i = 0; i < left_wins; i++)
+                    {
+                        keys.write(target, keys.getScratch(left++));
+                        keys.highlight(target++, HighlightType::PROCESSING);
+                    }
+                    if (left == mid) break;
+
+                    right_wins = gallop(right, end - right, 0, [&](std::size_t i) { return !keys.lessThanKey(i, keys.getScratch(left), left); });
+                    for (std::size_t i = 0; i < right_wins; i++)
+                    {
+                        keys.move(right++, target);
+                        keys.highlight(target++, HighlightType::PROCESSING);
+                    }
+                    if (right == end) break;
+
+                    if (min_gallop > 1) min_gallop--;
+                } while (left_wins >= initial_min_gallop || right_wins >= initial_min_gallop);
+
+                // Leaving gallop mode makes it harder to enter again
+                min_gallop += 2;
+            }
+
+            // The right run's leftovers are already in place
+            while (left < mid)
+            {
+                keys.write(target, keys.getScratch(left++));
+                keys.highlight(target++, HighlightType::PROCESSING);
+            }
+        }
+
+        // Right run is the shorter: it goes to scratch and the merge fills the keys from the back
+        void mergeHigh(Array& keys, std::size_t begin, std::size_t mid, std::size_t end)
+        {
+            for (std::size_t i = mid; i < end; i++)
+            {
+                keys.copyToScratch(i, i);
+                keys.highlight(i, HighlightType::TEMPORARY);
+            }
+
+            std::size_t left = mid;
+            std::size_t right = end;
+            std::size_t target = end;
+
+            while (left > begin && right > mid)
+            {
+                std::size_t left_wins = 0;
+                std::size_t right_wins = 0;
+
+                // From the back the right run wins ties
+                do
+                {
+                    if (keys.keyLessThan(keys.getScratch(right - 1), right - 1, left - 1))
+                    {
+                        keys.move(--left, --target);
+                        left_wins++;
+                        right_wins = 0;
+                    }
+                    else
+                    {
+                        keys.write(--target, keys.getScratch(--right));
+                        right_wins++;
+                        left_wins = 0;
+                    }
+                    keys.highlight(target, HighlightType::PROCESSING);
+                } while (left > begin && right > mid && std::max(left_wins, right_wins) < min_gallop);
+
+                if (left == begin || right == mid) break;
+
+                do
+                {
+                    std::size_t last_right = right - 1;
+                    left_wins = left - (begin + gallop(begin, left - begin, left - begin - 1, [&](std::size_t i) { return keys.keyLessThan(keys.getScratch(last_right), last_right, i); }));
+                    for (std::size_t i = 0; i < left_wins; i++)
+                    {
+                        keys.move(--left, --target);
+                        keys.highlight(target, HighlightType::PROCESSING);
+                    }
+                    if (left == begin) break;
+
+                    std::size_t last_left = left - 1;
+                    right_wins = right - (mid + gallop(mid, right - mid, right - mid - 1, [&](std::size_t i) { return !keys.keyLessThan(keys.getScratch(i), i, last_left); }));
+                    for (std::size_t i = 0; i < right_wins; i++)
+                    {
+                        keys.write(--target, keys.getScratch(--right));
+                        keys.highlight(target, HighlightType::PROCESSING);
+                    }
+                    if (right == mid) break;
+
+                    if (min_gallop > 1) min_gallop--;
+                } while (left_wins >= initial_min_gallop || right_wins >= initial_min_gallop);
+
+                min_gallop += 2;
+            }
+
+            // The left run's leftovers are already in place
+            while (right > mid)
+            {
+                keys.write(--target, keys.getScratch(--right));
+                keys.highlight(target, HighlightType::PROCESSING);
+            }
+        }
+
+    public:
+        void sort(Array& keys)
+        {
+            std::size_t size = keys.getSize();
+            if (size < 2) return;
+
+            std::size_t min_run = getMinRun(size);
+            run_stack.clear();
+            min_gallop = initial_min_gallop;
+
+            for (std::size_t begin = 0; begin < size;)
+            {
+                if (keys.isCancelled()) return;
+
+                std::size_t end = findRun(keys, begin, size);
+                keys.markPhase(PhaseType::RUN, begin, end);
+
+                if (end - begin < min_run)
+                {
+                    std::size_t forced_end = std::min(begin + min_run, size);
+                    binaryInsertionSort(keys, begin, forced_end, end);
+                    end = forced_end;
+                }
+
+                run_stack.push_back(Run{ begin, end - begin });
+                mergeCollapse(keys);
+                begin = end;
+            }
+
+            mergeForceCollapse(keys);
+        }
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace Sort
+{
+    namespace Trace
+    {
+        // Trace layout:
+        //   header     : magic "STRC", version byte, varint element count, zigzag varint initial keys
+        //   operations : tag byte (OperationType in the low 3 bits, highlight / phase type or compare load count above)
+        //                followed by varint fields. Indices are stored as zigzag deltas from the
+        //                previous index, so the neighbouring accesses of most sorts take one byte.
+        const unsigned char trace_magic[4] = { 'S', 'T', 'R', 'C' };
+        const unsigned char trace_version = 4;
+
+        const int operation_type_bits = 3;
+        const unsigned char operation_type_mask = (1 << operation_type_bits) - 1;
+
+        inline std::uint64_t encodeZigZag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        inline std::int64_t decodeZigZag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+        }
+
+        inline void writeVarint(std::vector<unsigned char>& buffer, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                buffer.push_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            buffer.push_back(static_cast<unsigned char>(value));
+        }
+
+        inline bool readVarint(const unsigned char*& cursor, const unsigned char* end, std::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; cursor < end && shift < 64; shift += 7)
+            {
+                unsigned char byte = *cursor++;
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Sort/SortOperation.h"
+#include "Global/MappedFile.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Sort
+{
+    namespace Trace
+    {
+        // Walks a recorded trace straight out of a memory mapping, one operation at a time.
+        class TracePlayer
+        {
+        private:
+            Global::MappedFile trace_file;
+
+            const unsigned char* operations_begin;
+            const unsigned char* cursor;
+            const unsigned char* end;
+
+            std::size_t last_index;
+            std::vector<int> initial_keys;
+
+            bool readHeader();
+            std::size_t readIndex(std::uint64_t encoded_delta);
+
+        public:
+            TracePlayer();
+            ~TracePlayer();
+
+            bool open(const std::string& path);
+            void close();
+            void rewind();
+
+            bool next(SortOperation& operation);
+
+            bool isOpen() const;
+            bool isFinished() const;
+            float getProgress() const;
+
+            std::size_t getNumberOfElements() const;
+            const std::vector<int>& getInitialKeys() const;
+        };
+    }
+}
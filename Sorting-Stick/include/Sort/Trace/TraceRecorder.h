@@ -0,0 +1,42 @@
+#pragma once
+#include "Sort/Interface/IOperationSink.h"
+#include "Global/StopToken.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Sort
+{
+    namespace Trace
+    {
+        // Operation sink that streams every operation of a sort run into a compact binary trace file.
+        class TraceRecorder : public Interface::IOperationSink
+        {
+        private:
+            const std::size_t buffer_capacity = 1 << 16;
+
+            std::ofstream trace_stream;
+            std::vector<unsigned char> buffer;
+
+            std::size_t last_index;
+            std::uint64_t number_of_operations;
+            Global::StopToken stop_token;
+
+            void writeIndex(std::size_t index);
+            void flush();
+
+        public:
+            TraceRecorder();
+            ~TraceRecorder();
+
+            bool open(const std::string& path, const int* keys, std::size_t size, Global::StopToken stop_token = Global::StopToken());
+            void close();
+
+            void onOperation(const SortOperation& operation) override;
+            bool isCancelled() override;
+
+            std::uint64_t getNumberOfOperations() const;
+        };
+    }
+}
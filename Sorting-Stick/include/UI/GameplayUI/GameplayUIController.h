@@ -20,8 +20,12 @@ namespace UI
 			const float array_access_text_x_position = 1170.f;
 
 			const float num_sticks_text_x_position = 60.f;
-			const float delay_text_x_position = 687.f;
-			const float time_complexity_text_x_position = 1250.f;
+			const float speed_text_x_position = 640.f;
+			const float time_complexity_text_x_position = 1330.f;
+
+			const float text_y_pos3 = 116.f;
+			const float cache_misses_text_x_position = 60.f;
+			const float miss_rate_text_x_position = 1170.f;
 
 			const float menu_button_x_position = 1770.f;
 			const float menu_button_y_position = 33.f;
@@ -36,8 +40,10 @@ namespace UI
 			UIElement::TextView* comparisons_text;
 			UIElement::TextView* array_access_text;
 			UIElement::TextView* num_sticks_text;
-			UIElement::TextView* delay_text;
+			UIElement::TextView* speed_text;
 			UIElement::TextView* time_complexity_text;
+			UIElement::TextView* cache_misses_text;
+			UIElement::TextView* miss_rate_text;
 			UIElement::ButtonView* menu_button;
 
 			void createButton();
@@ -49,10 +55,12 @@ namespace UI
 			void updateComparisonsText();
 			void updateArrayAccessText();
 			void updateNumberOfSticksText();
-			void updateDelayText();
+			void updateSpeedText();
 			void updateTimeComplexityText();
+			void updateCacheTexts();
 			void menuButtonCallback();
 			void registerButtonCallback();
+			bool clickedText(UIElement::TextView* text);
 
 			void destroy();
 
@@ -3,6 +3,7 @@
 #include "UI/Interface/IUIController.h"
 #include "UI/UIElement/ImageView.h"
 #include "UI/UIElement/ButtonView.h"
+#include "UI/UIElement/TextView.h"
 
 namespace UI
 {
@@ -28,6 +29,18 @@ namespace UI
 			const float radix_sort_button_y_position = 600.f;
 			const float quit_button_y_position = 830.f;
 
+			// Input Text:
+			const float input_text_y_position = 745.f;
+			const int input_text_font_size = 40;
+
+			// Sorts without a button of their own are listed as text between the two columns:
+			const float tim_sort_text_y_position = 205.f;
+			const float heap_sort_text_y_position = 315.f;
+			const float three_way_quick_sort_text_y_position = 425.f;
+			const float external_sort_text_y_position = 535.f;
+			const float multiway_merge_sort_text_y_position = 645.f;
+			const int sort_text_font_size = 45;
+
 			// References:
 			UIElement::ImageView* background_image;
 			UIElement::ButtonView* bubble_sort_button;
@@ -37,13 +50,21 @@ namespace UI
 			UIElement::ButtonView* quick_sort_button;
 			UIElement::ButtonView* radix_sort_button;
 			UIElement::ButtonView* quit_button;
+			UIElement::TextView* input_text;
+			UIElement::TextView* tim_sort_text;
+			UIElement::TextView* heap_sort_text;
+			UIElement::TextView* three_way_quick_sort_text;
+			UIElement::TextView* external_sort_text;
+			UIElement::TextView* multiway_merge_sort_text;
 
 			const float background_alpha = 85.f;
 
 			void createImage();
 			void createButtons();
+			void createTexts();
 			void initializeBackgroundImage();
 			void initializeButtons();
+			void initializeTexts();
 			void registerButtonCallback();
 
 			void bubbleSortButtonCallback();
@@ -54,6 +75,10 @@ namespace UI
 			void radixSortButtonCallback();
 			void quitButtonCallback();
 
+			void updateInputText();
+			void updateSortTexts();
+			bool clickedText(UIElement::TextView* text);
+
 			void destroy();
 
 		public:
@@ -0,0 +1,31 @@
+#pragma once
+#include "UIView.h"
+
+namespace UI
+{
+	namespace UIElement
+	{
+		// Draws any number of axis-aligned rectangles with a single draw call.
+		// Each rectangle is two triangles in one shared vertex array; setters only touch that rectangle's vertices.
+		class RectangleBatchView : public UIView
+		{
+		protected:
+			static const int vertices_per_rectangle = 6;
+
+			sf::VertexArray rectangle_vertices;
+
+		public:
+			RectangleBatchView();
+			virtual ~RectangleBatchView();
+
+			virtual void initialize(int rectangle_count);
+			virtual void update() override;
+			virtual void render() override;
+
+			virtual void setRectangle(int index, sf::Vector2f rectangle_size, sf::Vector2f rectangle_position);
+			virtual void setFillColor(int index, sf::Color fill_color);
+
+			int getRectangleCount();
+		};
+	}
+}
@@ -40,6 +40,7 @@ namespace UI
 
 			void setText(sf::String text_value);
 			void setTextCentreAligned();
+			sf::FloatRect getGlobalBounds() const;
 		};
 	}
 }
\ No newline at end of file
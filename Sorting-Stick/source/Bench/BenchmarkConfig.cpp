@@ -0,0 +1,288 @@
+#include "Bench/BenchmarkConfig.h"
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace Bench
+{
+	using Sort::SortType;
+	using namespace Sort::Input;
+
+	namespace
+	{
+		const SortType all_sort_types[] = { SortType::BUBBLE_SORT, SortType::INSERTION_SORT, SortType::SELECTION_SORT, SortType::MERGE_SORT, SortType::QUICK_SORT, SortType::RADIX_SORT, SortType::TIM_SORT, SortType::HEAP_SORT, SortType::THREE_WAY_QUICK_SORT, SortType::MULTIWAY_MERGE_SORT, SortType::EXTERNAL_MERGE_SORT };
+
+		std::vector<std::string> splitList(const std::string& list)
+		{
+			std::vector<std::string> items;
+			std::stringstream stream(list);
+			std::string item;
+
+			while (std::getline(stream, item, ',')) if (!item.empty()) items.push_back(item);
+			return items;
+		}
+
+		bool parseSize(const char* text, std::size_t& size)
+		{
+			// Accepts plain integers as well as 1e6 style powers of ten
+			char* end = nullptr;
+			double value = std::strtod(text, &end);
+			if (end == text || *end != '\0' || value < 1) return false;
+
+			size = static_cast<std::size_t>(value + 0.5);
+			return true;
+		}
+
+		// size:line:ways with optional K / M suffixes on the size, e.g. 32K:64:8
+		bool parseCacheLevel(const char* text, Sort::Metrics::CacheLevelConfig& level)
+		{
+			char* end = nullptr;
+			unsigned long long capacity = std::strtoull(text, &end, 10);
+			unsigned long long multiplier = 1;
+			if (*end == 'K' || *end == 'k') multiplier = 1024;
+			else if (*end == 'M' || *end == 'm') multiplier = 1024 * 1024;
+			if (multiplier > 1) end++;
+			capacity *= multiplier;
+			if (end == text || *end != ':') return false;
+
+			const char* line_text = end + 1;
+			unsigned long long line_size = std::strtoull(line_text, &end, 10);
+			if (end == line_text || *end != ':') return false;
+
+			const char* ways_text = end + 1;
+			unsigned long long associativity = std::strtoull(ways_text, &end, 10);
+			if (end == ways_text || *end != '\0') return false;
+
+			if (capacity == 0 || line_size == 0 || associativity == 0 || capacity < line_size * associativity) return false;
+
+			level.capacity = static_cast<std::size_t>(capacity);
+			level.line_size = static_cast<std::size_t>(line_size);
+			level.associativity = static_cast<std::size_t>(associativity);
+			return true;
+		}
+
+		// Bytes with an optional K / M / G suffix, e.g. 512M
+		bool parseBytes(const char* text, std::size_t& bytes)
+		{
+			char* end = nullptr;
+			unsigned long long value = std::strtoull(text, &end, 10);
+			if (end == text) return false;
+
+			if (*end == 'K' || *end == 'k') value <<= 10;
+			else if (*end == 'M' || *end == 'm') value <<= 20;
+			else if (*end == 'G' || *end == 'g') value <<= 30;
+			else end--;
+
+			if (*++end != '\0' || value == 0) return false;
+
+			bytes = static_cast<std::size_t>(value);
+			return true;
+		}
+
+		bool parseInt(const char* text, int& value)
+		{
+			char* end = nullptr;
+			long parsed = std::strtol(text, &end, 10);
+			if (end == text || *end != '\0' || parsed < 0) return false;
+
+			value = static_cast<int>(parsed);
+			return true;
+		}
+	}
+
+	bool parseArguments(int argc, char** argv, BenchmarkConfig& config, std::string& error)
+	{
+		// The external sort goes through files, so it only runs when asked for
+		config.sort_types.assign(std::begin(all_sort_types), std::end(all_sort_types) - 1);
+		config.distributions.clear();
+		for (int i = 0; i < number_of_distributions; i++) config.distributions.push_back(static_cast<Distribution>(i));
+
+		for (int i = 1; i < argc; i++)
+		{
+			std::string option = argv[i];
+
+			if (option == "--help")
+			{
+				error.clear();
+				return false;
+			}
+
+			if (i + 1 >= argc)
+			{
+				error = "missing value for " + option;
+				return false;
+			}
+
+			const char* value = argv[++i];
+			bool is_valid = true;
+
+			if (option == "--sorts")
+			{
+				config.sort_types.clear();
+				for (const std::string& name : splitList(value))
+				{
+					bool is_found = false;
+					for (SortType sort_type : all_sort_types)
+					{
+						if (name == getSortName(sort_type))
+						{
+							config.sort_types.push_back(sort_type);
+							is_found = true;
+						}
+					}
+					is_valid = is_valid && is_found;
+				}
+			}
+			else if (option == "--distributions")
+			{
+				config.distributions.clear();
+				for (const std::string& name : splitList(value))
+				{
+					Distribution distribution;
+					if (parseDistribution(name.c_str(), distribution)) config.distributions.push_back(distribution);
+					else is_valid = false;
+				}
+			}
+			else if (option == "--min-n") is_valid = parseSize(value, config.min_size);
+			else if (option == "--max-n") is_valid = parseSize(value, config.max_size);
+			else if (option == "--max-quadratic-n") is_valid = parseSize(value, config.max_quadratic_size);
+			else if (option == "--max-counted-n") is_valid = parseSize(value, config.max_counted_size);
+			else if (option == "--cache-model")
+			{
+				std::string state = value;
+				if (state == "on") config.is_cache_model_enabled = true;
+				else if (state == "off") config.is_cache_model_enabled = false;
+				else is_valid = false;
+			}
+			else if (option == "--hardware-counters")
+			{
+				std::string state = value;
+				if (state == "on") config.is_hardware_counters_enabled = true;
+				else if (state == "off") config.is_hardware_counters_enabled = false;
+				else is_valid = false;
+			}
+			else if (option == "--l1") is_valid = parseCacheLevel(value, config.cache_config.levels[static_cast<int>(Sort::Metrics::CacheLevel::L1)]);
+			else if (option == "--l2") is_valid = parseCacheLevel(value, config.cache_config.levels[static_cast<int>(Sort::Metrics::CacheLevel::L2)]);
+			else if (option == "--llc") is_valid = parseCacheLevel(value, config.cache_config.levels[static_cast<int>(Sort::Metrics::CacheLevel::LLC)]);
+			else if (option == "--threads")
+			{
+				int threads = 0;
+				is_valid = parseInt(value, threads);
+				config.number_of_threads = static_cast<unsigned>(threads);
+			}
+			else if (option == "--heap-arity")
+			{
+				int arity = 0;
+				is_valid = parseInt(value, arity) && (arity == 2 || arity == 4 || arity == 8);
+				config.heap_arity = static_cast<unsigned>(arity);
+			}
+			else if (option == "--external-memory") is_valid = parseBytes(value, config.external_memory_budget);
+			else if (option == "--external-path") config.external_path = value;
+			else if (option == "--dataset")
+			{
+				config.dataset_path = value;
+				config.distributions.assign(1, Distribution::DATASET);
+			}
+			else if (option == "--dataset-type") is_valid = parseDatasetType(value, config.dataset_type);
+			else if (option == "--key-type") is_valid = parseDatasetType(value, config.key_type);
+			else if (option == "--sort-file") config.sort_file_path = value;
+			else if (option == "--sorted-file") config.sorted_file_path = value;
+			else if (option == "--warmup") is_valid = parseInt(value, config.warmup_runs);
+			else if (option == "--repetitions") is_valid = parseInt(value, config.repetitions) && config.repetitions > 0;
+			else if (option == "--seed") config.seed = std::strtoull(value, nullptr, 10);
+			else if (option == "--format")
+			{
+				std::string format = value;
+				if (format == "csv") config.output_format = OutputFormat::CSV;
+				else if (format == "json") config.output_format = OutputFormat::JSON;
+				else is_valid = false;
+			}
+			else if (option == "--output") config.output_path = value;
+			else
+			{
+				error = "unknown option " + option;
+				return false;
+			}
+
+			if (!is_valid)
+			{
+				error = "invalid value '" + std::string(value) + "' for " + option;
+				return false;
+			}
+		}
+
+		if (config.sort_file_path.empty() != config.sorted_file_path.empty())
+		{
+			error = "--sort-file and --sorted-file go together";
+			return false;
+		}
+
+		return true;
+	}
+
+	void printUsage()
+	{
+		std::cerr <<
+			"usage: sorting-bench [options]\n"
+			"  --sorts bubble,insertion,selection,merge,quick,radix,tim,heap,quick3,multiway,external\n"
+			"                         all but external by default\n"
+			"  --distributions permutation,sorted,reversed,nearly-sorted,few-unique,organ-pipe,sawtooth,runs,zipf,random\n"
+			"  --min-n 1e3            smallest N of the sweep\n"
+			"  --max-n 1e8            largest N of the sweep, N grows by powers of ten\n"
+			"  --max-quadratic-n 1e5  largest N for the O(n^2) sorts\n"
+			"  --max-counted-n 1e6    largest N that also gets an instrumented run for operation counts\n"
+			"                         (builds with SORT_DISABLE_COUNTERS skip it)\n"
+			"  --cache-model on|off   estimate L1 / L2 / LLC misses during the instrumented run, off by default\n"
+			"  --l1 32K:64:8          simulated cache size:line:ways, likewise --l2 1M:64:16 and --llc 16M:64:16\n"
+			"  --hardware-counters on|off\n"
+			"                         perf_event_open counters around each timed run, on by default,\n"
+			"                         timing only when the kernel refuses them\n"
+			"  --threads 0            threads of the native merge and quick sorts, 0 uses every core\n"
+			"  --heap-arity 4         children per node of the heap sort's heap: 2, 4 or 8\n"
+			"  --external-memory 64M  memory of the external sort, K / M / G suffixes\n"
+			"  --external-path path   prefix of the external sort's temporary files\n"
+			"  --dataset path         sort the first N keys of a key file instead of the distributions\n"
+			"  --dataset-type int32   int32|int64|float32|float64, for files without a header; the keys are\n"
+			"                         sorted in their own type\n"
+			"  --key-type int32       int32|int64|float32|float64 keys for the distributions, cast from the\n"
+			"                         int ones, floats halved\n"
+			"  --sort-file in --sorted-file out\n"
+			"                         sorts a file of native int32 keys with the external sort and exits,\n"
+			"                         taking --external-memory and --threads\n"
+			"  --warmup 1             untimed runs before measuring\n"
+			"  --repetitions 5        timed runs per case\n"
+			"  --seed 42              seed for the input generators\n"
+			"  --format csv|json\n"
+			"  --output path          defaults to stdout\n";
+	}
+
+	const char* getSortName(SortType sort_type)
+	{
+		switch (sort_type)
+		{
+		case SortType::BUBBLE_SORT:
+			return "bubble";
+		case SortType::INSERTION_SORT:
+			return "insertion";
+		case SortType::SELECTION_SORT:
+			return "selection";
+		case SortType::MERGE_SORT:
+			return "merge";
+		case SortType::QUICK_SORT:
+			return "quick";
+		case SortType::RADIX_SORT:
+			return "radix";
+		case SortType::TIM_SORT:
+			return "tim";
+		case SortType::HEAP_SORT:
+			return "heap";
+		case SortType::THREE_WAY_QUICK_SORT:
+			return "quick3";
+		case SortType::MULTIWAY_MERGE_SORT:
+			return "multiway";
+		case SortType::EXTERNAL_MERGE_SORT:
+			return "external";
+		}
+		return "unknown";
+	}
+}
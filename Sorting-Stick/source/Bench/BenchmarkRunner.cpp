@@ -0,0 +1,182 @@
+#include "Bench/BenchmarkRunner.h"
+#include "Sort/External/ExternalMergeSort.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace Bench
+{
+	using Sort::SortType;
+	using namespace Sort::Input;
+
+	BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config) : config(config)
+	{
+		operation_counter = new OperationCounter();
+		if (config.is_cache_model_enabled) operation_counter->enableMemoryModel(config.cache_config);
+		input_generator = new InputGenerator(config.seed);
+
+		dataset = new Dataset();
+		key_array = nullptr;
+
+		hardware_counters = new HardwareCounters();
+		if (config.is_hardware_counters_enabled && !hardware_counters->open())
+			std::cerr << "hardware counters unavailable (" << hardware_counters->getError() << "), timing only" << std::endl;
+	}
+
+	BenchmarkRunner::~BenchmarkRunner()
+	{
+		delete (key_array);
+		delete (operation_counter);
+		delete (input_generator);
+		delete (dataset);
+		delete (hardware_counters);
+	}
+
+	bool BenchmarkRunner::open()
+	{
+		if (!config.dataset_path.empty() && !dataset->open(config.dataset_path, config.dataset_type))
+		{
+			std::cerr << "cannot load dataset: " << dataset->getError() << std::endl;
+			return false;
+		}
+
+		key_array = createKeyArray(config, *input_generator, *dataset);
+		return true;
+	}
+
+	bool BenchmarkRunner::run(ResultWriter& result_writer)
+	{
+		bool is_output_sorted = true;
+		result_writer.begin();
+
+		for (std::size_t size = config.min_size; size <= config.max_size; size *= 10)
+		{
+			for (Distribution distribution : config.distributions)
+			{
+				// Only a dataset runs out of keys, the sizes past its end are skipped rather than sorted short
+				if (!key_array->load(distribution, size))
+				{
+					std::cerr << "dataset has " << dataset->getNumberOfKeys() << " keys, skipping size " << size << std::endl;
+					continue;
+				}
+
+				for (SortType sort_type : config.sort_types)
+				{
+					if (isQuadratic(sort_type) && size > config.max_quadratic_size) continue;
+
+					std::cerr << getSortName(sort_type) << " / " << getDistributionName(distribution) << " / " << size << std::endl;
+
+					// The timed runs' output is checked, the instrumented run sorts another copy
+					BenchmarkResult result = runCase(sort_type, distribution, size);
+					if (!isOutputCorrect(size)) is_output_sorted = false;
+
+					// Builds with SORT_DISABLE_COUNTERS have nothing to count with
+					if (OperationCounter::is_enabled && size <= config.max_counted_size) countOperations(sort_type, result);
+
+					result_writer.write(result);
+				}
+			}
+
+			if (size > config.max_size / 10) break;
+		}
+
+		result_writer.end();
+		return is_output_sorted;
+	}
+
+	bool BenchmarkRunner::sortFile()
+	{
+		Sort::External::ExternalMergeSort external_merge_sort;
+		external_merge_sort.setMemoryBudget(config.external_memory_budget);
+		external_merge_sort.setNumberOfThreads(config.number_of_threads);
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		bool is_sorted = external_merge_sort.sort(config.sort_file_path, config.sorted_file_path);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		if (!is_sorted)
+		{
+			std::cerr << "external sort failed: " << external_merge_sort.getError() << std::endl;
+			return false;
+		}
+
+		std::cerr << "sorted " << config.sort_file_path << " into " << config.sorted_file_path << " in "
+			<< std::chrono::duration<double>(end - start).count() << " s" << std::endl;
+		return true;
+	}
+
+	// Sorting a copy of the input to compare with is as slow as an instrumented run, so it stops at the same size
+	bool BenchmarkRunner::isOutputCorrect(std::size_t size)
+	{
+		if (!key_array->isSorted())
+		{
+			std::cerr << "  output is not sorted" << std::endl;
+			return false;
+		}
+
+		if (size <= config.max_counted_size && !key_array->isPermutation())
+		{
+			std::cerr << "  output is not a permutation of the input" << std::endl;
+			return false;
+		}
+
+		return true;
+	}
+
+	bool BenchmarkRunner::isQuadratic(SortType sort_type)
+	{
+		return sort_type == SortType::BUBBLE_SORT || sort_type == SortType::INSERTION_SORT || sort_type == SortType::SELECTION_SORT;
+	}
+
+	BenchmarkResult BenchmarkRunner::runCase(SortType sort_type, Distribution distribution, std::size_t size)
+	{
+		BenchmarkResult result = {};
+		result.sort_type = sort_type;
+		result.distribution = distribution;
+		result.size = size;
+		result.repetitions = config.repetitions;
+
+		HardwareCounts hardware_counts;
+		for (int i = 0; i < config.warmup_runs; i++) timeSort(sort_type, hardware_counts);
+
+		std::vector<double> run_times;
+		for (int i = 0; i < config.repetitions; i++)
+		{
+			run_times.push_back(timeSort(sort_type, hardware_counts));
+
+			// Keep the counters of the fastest run so they line up with best_ns_per_element
+			if (run_times.back() <= *std::min_element(run_times.begin(), run_times.end())) result.hardware_counts = hardware_counts;
+		}
+
+		std::sort(run_times.begin(), run_times.end());
+		result.best_ns_per_element = run_times.front() / size;
+		result.median_ns_per_element = run_times[run_times.size() / 2] / size;
+		result.throughput = 1000.0 / result.best_ns_per_element;
+		return result;
+	}
+
+	double BenchmarkRunner::timeSort(SortType sort_type, HardwareCounts& hardware_counts)
+	{
+		key_array->reset();
+
+		hardware_counters->start();
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		key_array->sort(sort_type);
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		hardware_counts = hardware_counters->stop();
+
+		return std::chrono::duration<double, std::nano>(end - start).count();
+	}
+
+	void BenchmarkRunner::countOperations(SortType sort_type, BenchmarkResult& result)
+	{
+		key_array->reset();
+		key_array->countOperations(sort_type, *operation_counter);
+
+		result.is_counted = true;
+		result.counter_values = operation_counter->getCounterValues();
+
+		result.is_cache_modelled = operation_counter->isMemoryModelEnabled();
+		result.cache_statistics = operation_counter->getCacheStatistics();
+	}
+}
@@ -0,0 +1,154 @@
+#include "Bench/HardwareCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace Bench
+{
+#ifdef __linux__
+	namespace
+	{
+		struct EventType
+		{
+			std::uint32_t type;
+			std::uint64_t config;
+		};
+
+		const EventType event_types[number_of_hardware_events] =
+		{
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND },
+		};
+
+		int openEvent(const EventType& event_type, int group_descriptor)
+		{
+			perf_event_attr attributes;
+			std::memset(&attributes, 0, sizeof(attributes));
+			attributes.size = sizeof(attributes);
+			attributes.type = event_type.type;
+			attributes.config = event_type.config;
+			attributes.disabled = group_descriptor == -1 ? 1 : 0; //members follow their leader
+			attributes.exclude_kernel = 1;
+			attributes.exclude_hv = 1;
+			attributes.inherit = 1; //the parallel sorts' threads count too
+			attributes.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			return static_cast<int>(syscall(__NR_perf_event_open, &attributes, 0, -1, group_descriptor, 0));
+		}
+	}
+#endif
+
+	HardwareCounters::HardwareCounters()
+	{
+		for (int& descriptor : event_descriptors) descriptor = -1;
+	}
+
+	HardwareCounters::~HardwareCounters() { close(); }
+
+	bool HardwareCounters::open()
+	{
+		close();
+
+#ifdef __linux__
+		int leader = openEvent(event_types[0], -1);
+		if (leader == -1)
+		{
+			error = std::string("perf_event_open: ") + std::strerror(errno);
+			return false;
+		}
+
+		event_descriptors[0] = leader;
+		for (int i = 1; i < number_of_hardware_events; i++) event_descriptors[i] = openEvent(event_types[i], leader);
+
+		error.clear();
+		return true;
+#else
+		error = "hardware counters need Linux perf_event_open";
+		return false;
+#endif
+	}
+
+	void HardwareCounters::close()
+	{
+#ifdef __linux__
+		// Members first, the leader last
+		for (int i = number_of_hardware_events - 1; i >= 0; i--)
+		{
+			if (event_descriptors[i] != -1) ::close(event_descriptors[i]);
+			event_descriptors[i] = -1;
+		}
+#endif
+	}
+
+	bool HardwareCounters::isAvailable() const { return event_descriptors[0] != -1; }
+
+	const std::string& HardwareCounters::getError() const { return error; }
+
+	void HardwareCounters::start()
+	{
+#ifdef __linux__
+		if (!isAvailable()) return;
+
+		ioctl(event_descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(event_descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+	}
+
+	HardwareCounts HardwareCounters::stop()
+	{
+		HardwareCounts counts;
+
+#ifdef __linux__
+		if (!isAvailable()) return counts;
+
+		ioctl(event_descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		for (int i = 0; i < number_of_hardware_events; i++)
+		{
+			if (event_descriptors[i] == -1) continue;
+
+			// value, time enabled, time running
+			std::uint64_t reading[3];
+			if (read(event_descriptors[i], reading, sizeof(reading)) != static_cast<ssize_t>(sizeof(reading)) || reading[2] == 0) continue;
+
+			// Scale up if the kernel had to multiplex the group off the PMU for part of the run
+			double scale = reading[2] < reading[1] ? static_cast<double>(reading[1]) / reading[2] : 1.0;
+
+			counts.is_counted[i] = true;
+			counts.values[i] = static_cast<std::uint64_t>(reading[0] * scale + 0.5);
+		}
+#endif
+
+		return counts;
+	}
+
+	const char* HardwareCounters::getEventName(HardwareEvent event)
+	{
+		switch (event)
+		{
+		case HardwareEvent::CYCLES:
+			return "cycles";
+		case HardwareEvent::INSTRUCTIONS:
+			return "instructions";
+		case HardwareEvent::BRANCH_MISSES:
+			return "branch_misses";
+		case HardwareEvent::L1D_MISSES:
+			return "l1d_hw_misses";
+		case HardwareEvent::LLC_MISSES:
+			return "llc_hw_misses";
+		case HardwareEvent::STALLED_CYCLES:
+			return "stalled_cycles";
+		}
+		return "";
+	}
+}
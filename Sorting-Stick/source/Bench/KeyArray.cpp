@@ -0,0 +1,78 @@
+#include "Bench/KeyArray.h"
+#include <cstdint>
+
+namespace Bench
+{
+	using Sort::SortType;
+	using namespace Sort::Input;
+
+	IntKeyArray::IntKeyArray(const BenchmarkConfig& config, InputGenerator& input_generator, const Dataset& dataset)
+		: input_generator(input_generator), dataset(dataset)
+	{
+		sort_engine = new Sort::SortEngine();
+		sort_engine->setNumberOfThreads(config.number_of_threads);
+		sort_engine->setHeapArity(config.heap_arity);
+		sort_engine->setExternalSortOptions(config.external_memory_budget, config.external_path);
+	}
+
+	IntKeyArray::~IntKeyArray() { delete (sort_engine); }
+
+	bool IntKeyArray::load(Distribution distribution, std::size_t size)
+	{
+		if (distribution == Distribution::DATASET && size > dataset.getNumberOfKeys()) return false;
+
+		input_keys.resize(size);
+		if (distribution == Distribution::DATASET) dataset.copyKeys(0, size, input_keys.data());
+		else input_generator.generate(distribution, input_keys.data(), size);
+
+		return true;
+	}
+
+	void IntKeyArray::reset() { keys = input_keys; }
+
+	void IntKeyArray::sort(SortType sort_type)
+	{
+		sort_engine->setOperationSink(nullptr);
+		sort_engine->sort(sort_type, keys.data(), keys.size());
+	}
+
+	void IntKeyArray::countOperations(SortType sort_type, OperationCounter& operation_counter)
+	{
+		// Counted on the same algorithm source the visualizer replays
+		operation_counter.reset(keys.size());
+		sort_engine->setOperationCounters(operation_counter.getOperationCounters(), operation_counter.getMemoryModel());
+		sort_engine->sort(sort_type, keys.data(), keys.size());
+		sort_engine->setOperationCounters(nullptr);
+	}
+
+	bool IntKeyArray::isSorted() const { return std::is_sorted(keys.begin(), keys.end()); }
+
+	bool IntKeyArray::isPermutation() const
+	{
+		std::vector<int> sorted_input = input_keys;
+		std::sort(sorted_input.begin(), sorted_input.end());
+
+		std::vector<int> sorted_keys = keys;
+		std::sort(sorted_keys.begin(), sorted_keys.end());
+		return sorted_keys == sorted_input;
+	}
+
+	std::size_t IntKeyArray::getSize() const { return keys.size(); }
+
+	KeyArray* createKeyArray(const BenchmarkConfig& config, InputGenerator& input_generator, const Dataset& dataset)
+	{
+		DatasetType key_type = dataset.isOpen() ? dataset.getKeyType() : config.key_type;
+
+		switch (key_type)
+		{
+		case DatasetType::INT64:
+			return new TypedKeyArray<std::int64_t>(config, input_generator, dataset);
+		case DatasetType::FLOAT32:
+			return new TypedKeyArray<float>(config, input_generator, dataset);
+		case DatasetType::FLOAT64:
+			return new TypedKeyArray<double>(config, input_generator, dataset);
+		default:
+			return new IntKeyArray(config, input_generator, dataset);
+		}
+	}
+}
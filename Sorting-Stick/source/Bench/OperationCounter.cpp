@@ -0,0 +1,31 @@
+#include "Bench/OperationCounter.h"
+
+namespace Bench
+{
+	OperationCounter::OperationCounter()
+	{
+		is_memory_model_enabled = false;
+	}
+
+	void OperationCounter::enableMemoryModel(const Sort::Metrics::CacheConfig& cache_config)
+	{
+		memory_model.configure(cache_config);
+		is_memory_model_enabled = true;
+	}
+
+	bool OperationCounter::isMemoryModelEnabled() const { return is_memory_model_enabled; }
+
+	void OperationCounter::reset(std::size_t size, std::size_t element_size)
+	{
+		operation_counters.reset();
+		if (is_memory_model_enabled) memory_model.reset(size, element_size);
+	}
+
+	Sort::Metrics::OperationCounters<>* OperationCounter::getOperationCounters() { return &operation_counters; }
+
+	Sort::Metrics::MemoryModel* OperationCounter::getMemoryModel() { return is_memory_model_enabled ? &memory_model : nullptr; }
+
+	Sort::Metrics::CounterValues OperationCounter::getCounterValues() const { return operation_counters.read(); }
+
+	const Sort::Metrics::CacheStatistics& OperationCounter::getCacheStatistics() const { return memory_model.getStatistics(); }
+}
@@ -0,0 +1,138 @@
+#include "Bench/ResultWriter.h"
+
+namespace Bench
+{
+	using Sort::Input::getDistributionName;
+	using Sort::Metrics::CounterType;
+	using Sort::Metrics::CacheLevel;
+
+	namespace
+	{
+		const CacheLevel all_cache_levels[] = { CacheLevel::L1, CacheLevel::L2, CacheLevel::LLC };
+		const char* const cache_level_names[] = { "l1", "l2", "llc" };
+		const HardwareEvent all_hardware_events[] = { HardwareEvent::CYCLES, HardwareEvent::INSTRUCTIONS, HardwareEvent::BRANCH_MISSES, HardwareEvent::L1D_MISSES, HardwareEvent::LLC_MISSES, HardwareEvent::STALLED_CYCLES };
+	}
+
+	ResultWriter::ResultWriter(std::ostream& output, OutputFormat output_format) : output(output)
+	{
+		this->output_format = output_format;
+		number_of_results = 0;
+	}
+
+	void ResultWriter::begin()
+	{
+		number_of_results = 0;
+
+		if (output_format == OutputFormat::CSV)
+		{
+			output << "sort,distribution,n,repetitions,best_ns_per_element,median_ns_per_element,throughput_mkeys_per_s,";
+			for (HardwareEvent event : all_hardware_events) output << HardwareCounters::getEventName(event) << ',';
+			output << "comparisons,reads,writes,swaps,auxiliary_writes,array_accesses,l1_misses,l2_misses,llc_misses,l1_miss_rate,l2_miss_rate,llc_miss_rate\n";
+		}
+		else output << "[";
+	}
+
+	void ResultWriter::write(const BenchmarkResult& result)
+	{
+		if (output_format == OutputFormat::CSV) writeCSV(result);
+		else writeJSON(result);
+
+		number_of_results++;
+		output.flush();
+	}
+
+	void ResultWriter::end()
+	{
+		if (output_format == OutputFormat::JSON) output << (number_of_results ? "\n]\n" : "]\n");
+		output.flush();
+	}
+
+	void ResultWriter::writeCSV(const BenchmarkResult& result)
+	{
+		output << getSortName(result.sort_type) << ',' << getDistributionName(result.distribution) << ','
+			<< result.size << ',' << result.repetitions << ','
+			<< result.best_ns_per_element << ',' << result.median_ns_per_element << ',' << result.throughput << ',';
+
+		for (HardwareEvent event : all_hardware_events)
+		{
+			if (result.hardware_counts.has(event)) output << result.hardware_counts.get(event);
+			output << ',';
+		}
+
+		// Uncounted cases leave the columns empty rather than claiming zero
+		const Sort::Metrics::CounterValues& counters = result.counter_values;
+		if (result.is_counted)
+		{
+			output << counters.get(CounterType::COMPARISONS) << ',' << counters.get(CounterType::READS) << ',' << counters.get(CounterType::WRITES) << ','
+				<< counters.get(CounterType::SWAPS) << ',' << counters.get(CounterType::AUXILIARY_WRITES) << ',' << counters.getArrayAccess();
+		}
+		else output << ",,,,,";
+
+		writeCacheCSV(result);
+		output << '\n';
+	}
+
+	void ResultWriter::writeJSON(const BenchmarkResult& result)
+	{
+		output << (number_of_results ? ",\n" : "\n")
+			<< "  {\"sort\": \"" << getSortName(result.sort_type) << "\", \"distribution\": \"" << getDistributionName(result.distribution) << "\""
+			<< ", \"n\": " << result.size << ", \"repetitions\": " << result.repetitions
+			<< ", \"best_ns_per_element\": " << result.best_ns_per_element << ", \"median_ns_per_element\": " << result.median_ns_per_element
+			<< ", \"throughput_mkeys_per_s\": " << result.throughput;
+
+		for (HardwareEvent event : all_hardware_events)
+		{
+			output << ", \"" << HardwareCounters::getEventName(event) << "\": ";
+			if (result.hardware_counts.has(event)) output << result.hardware_counts.get(event);
+			else output << "null";
+		}
+
+		const Sort::Metrics::CounterValues& counters = result.counter_values;
+		if (result.is_counted)
+		{
+			output << ", \"comparisons\": " << counters.get(CounterType::COMPARISONS) << ", \"reads\": " << counters.get(CounterType::READS)
+				<< ", \"writes\": " << counters.get(CounterType::WRITES) << ", \"swaps\": " << counters.get(CounterType::SWAPS)
+				<< ", \"auxiliary_writes\": " << counters.get(CounterType::AUXILIARY_WRITES) << ", \"array_accesses\": " << counters.getArrayAccess();
+		}
+		else output << ", \"comparisons\": null, \"reads\": null, \"writes\": null, \"swaps\": null, \"auxiliary_writes\": null, \"array_accesses\": null";
+
+		writeCacheJSON(result);
+		output << "}";
+	}
+
+	void ResultWriter::writeCacheCSV(const BenchmarkResult& result)
+	{
+		bool is_modelled = result.is_counted && result.is_cache_modelled;
+
+		for (CacheLevel level : all_cache_levels)
+		{
+			output << ',';
+			if (is_modelled) output << result.cache_statistics.getMisses(level);
+		}
+
+		for (CacheLevel level : all_cache_levels)
+		{
+			output << ',';
+			if (is_modelled) output << result.cache_statistics.getMissRate(level);
+		}
+	}
+
+	void ResultWriter::writeCacheJSON(const BenchmarkResult& result)
+	{
+		bool is_modelled = result.is_counted && result.is_cache_modelled;
+
+		for (CacheLevel level : all_cache_levels)
+		{
+			output << ", \"" << cache_level_names[static_cast<int>(level)] << "_misses\": ";
+			if (is_modelled) output << result.cache_statistics.getMisses(level);
+			else output << "null";
+		}
+
+		for (CacheLevel level : all_cache_levels)
+		{
+			output << ", \"" << cache_level_names[static_cast<int>(level)] << "_miss_rate\": ";
+			if (is_modelled) output << result.cache_statistics.getMissRate(level);
+			else output << "null";
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#include "Gameplay/Collection/StepScheduler.h"
+#include <algorithm>
+
+namespace Gameplay
+{
+	namespace Collection
+	{
+		StepScheduler::StepScheduler()
+		{
+			schedule_mode = ScheduleMode::OPERATIONS_PER_SECOND;
+			operations_per_second = 1;
+			operations_per_frame = 1;
+			time_budget_microseconds = 1000;
+
+			reset();
+		}
+
+		StepScheduler::~StepScheduler() = default;
+
+		void StepScheduler::setOperationsPerSecond(double operations)
+		{
+			schedule_mode = ScheduleMode::OPERATIONS_PER_SECOND;
+			operations_per_second = std::max(operations, 0.0);
+		}
+
+		void StepScheduler::setOperationsPerFrame(std::uint64_t operations)
+		{
+			schedule_mode = ScheduleMode::OPERATIONS_PER_FRAME;
+			operations_per_frame = operations;
+		}
+
+		void StepScheduler::setTimeBudget(std::int64_t microseconds)
+		{
+			schedule_mode = ScheduleMode::TIME_BUDGET;
+			time_budget_microseconds = microseconds;
+		}
+
+		void StepScheduler::reset()
+		{
+			available_operations = 0;
+			measured_operations_per_second = 0;
+			frame_steps = 0;
+			frame_checks = 0;
+			frame_exhausted = false;
+			frame_clock.restart();
+			budget_clock.restart();
+		}
+
+		void StepScheduler::beginFrame()
+		{
+			float frame_seconds = frame_clock.restart().asSeconds();
+			float elapsed_seconds = std::min(frame_seconds, max_carried_seconds);
+
+			if (frame_seconds > 0) measured_operations_per_second = frame_steps / frame_seconds;
+			frame_steps = 0;
+			frame_checks = 0;
+			frame_exhausted = false;
+			budget_clock.restart();
+
+			switch (schedule_mode)
+			{
+			case ScheduleMode::OPERATIONS_PER_SECOND:
+				// Fractions carry over, so 1 op/s advances exactly once a second at any frame rate
+				available_operations = std::min(available_operations + elapsed_seconds * operations_per_second,
+					std::max(1.0, operations_per_second * max_carried_seconds));
+				break;
+
+			case ScheduleMode::OPERATIONS_PER_FRAME:
+				available_operations = static_cast<double>(operations_per_frame);
+				break;
+
+			case ScheduleMode::TIME_BUDGET:
+				available_operations = 0;
+				break;
+			}
+		}
+
+		bool StepScheduler::canStep()
+		{
+			if (schedule_mode != ScheduleMode::TIME_BUDGET) return available_operations >= 1;
+
+			// Reading the clock every step would cost more than the steps themselves. Free operations never
+			// step, so the interval counts calls rather than steps.
+			if (!frame_exhausted && frame_checks++ % time_check_interval == 0)
+				frame_exhausted = budget_clock.getElapsedTime().asMicroseconds() >= time_budget_microseconds;
+
+			return !frame_exhausted;
+		}
+
+		void StepScheduler::step()
+		{
+			frame_steps++;
+			if (schedule_mode != ScheduleMode::TIME_BUDGET) available_operations -= 1;
+		}
+
+		ScheduleMode StepScheduler::getScheduleMode() { return schedule_mode; }
+
+		double StepScheduler::getOperationsPerSecond()
+		{
+			if (schedule_mode == ScheduleMode::OPERATIONS_PER_SECOND) return operations_per_second;
+			return measured_operations_per_second;
+		}
+	}
+}
@@ -3,9 +3,9 @@
 #include "Gameplay/Collection/StickCollectionModel.h"
 #include "Gameplay/GameplayService.h"
 #include "Global/ServiceLocator.h"
-#include "Gameplay/Collection/Stick.h"
+#include "Global/Config.h"
+#include <algorithm>
 #include <random>
-#include <iostream>
 
 namespace Gameplay
 {
@@ -19,8 +19,33 @@ namespace Gameplay
 		{
 			collection_view = new StickCollectionView();
 			collection_model = new StickCollectionModel();
-
-			for (int i = 0; i < collection_model->number_of_elements; i++) sticks.push_back(new Stick(i));
+			sort_engine = new Sort::SortEngine();
+			sort_engine->setHeapArity(collection_model->heap_arity);
+			sort_engine->setExternalSortOptions(collection_model->external_memory_budget, Config::external_sort_path.toAnsiString());
+			step_scheduler = new StepScheduler();
+			applied_replay_speed = -1;
+			replay_speed = 0;
+			schedule_mode = ScheduleMode::OPERATIONS_PER_SECOND;
+			operations_per_second = 0;
+			trace_recorder = new Sort::Trace::TraceRecorder();
+			trace_player = new Sort::Trace::TracePlayer();
+			input_generator = new Sort::Input::InputGenerator();
+			input_distribution = Sort::Input::Distribution::PERMUTATION;
+			dataset = new Sort::Input::Dataset();
+			memory_model = new Sort::Metrics::MemoryModel(collection_model->cache_config);
+
+			is_sort_finished = false;
+			compare_sound_played = false;
+			number_of_runs = 0;
+
+			stick_keys.resize(collection_model->number_of_elements);
+
+			// Real keys when a dataset is there, the generated distributions otherwise
+			if (dataset->open(Config::stick_dataset_path.toAnsiString()) && dataset->getNumberOfKeys() >= stick_keys.size()) input_distribution = Sort::Input::Distribution::DATASET;
+			else dataset->close();
+
+			stick_colors.assign(stick_keys.size(), collection_model->element_color);
+			dirty_sticks.assign(stick_keys.size(), false);
 		}
 
 		StickCollectionController::~StickCollectionController()
@@ -31,6 +56,7 @@ namespace Gameplay
 		void StickCollectionController::initialize()
 		{
 			sort_state = SortState::NOT_SORTING;
+			sort_engine->setOperationSink(trace_recorder);
 			collection_view->initialize(this);
 			initializeSticks();
 			reset();
@@ -38,35 +64,27 @@ namespace Gameplay
 
 		void StickCollectionController::initializeSticks()
 		{
-			float rectangle_width = calculateStickWidth();
-
-
-			for (int i = 0; i < collection_model->number_of_elements; i++)
-			{
-				float rectangle_height = calculateStickHeight(i); //calc height
+			stick_width = calculateStickWidth();
 
-				sf::Vector2f rectangle_size = sf::Vector2f(rectangle_width, rectangle_height);
-
-				sticks[i]->stick_view->initialize(rectangle_size, sf::Vector2f(0, 0), 0, collection_model->element_color);
-			}
+			resetSticksColor();
+			updateStickPosition();
 		}
 
 		void StickCollectionController::update()
 		{
 			processSortThreadState();
 			collection_view->update();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->update();
 		}
 
 		void StickCollectionController::render()
 		{
 			collection_view->render();
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->render();
 		}
 
 		float StickCollectionController::calculateStickWidth()
 		{
-			float total_space = static_cast<float>(ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->getSize().x);
+			// Work in reference resolution units, the batch view scales to the real window
+			float total_space = ServiceLocator::getInstance()->getGraphicService()->getReferenceResolution().x;
 
 			// Calculate total spacing as 10% of the total space
 			float total_spacing = collection_model->space_percentage * total_space;
@@ -91,587 +109,468 @@ namespace Gameplay
 
 		void StickCollectionController::updateStickPosition()
 		{
-			for (int i = 0; i < sticks.size(); i++)
-			{
-				float x_position = (i * sticks[i]->stick_view->getSize().x) + ((i + 1) * collection_model->elements_spacing);
-				float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
-
-				sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
-			}
+			for (int i = 0; i < stick_keys.size(); i++) updateStickPosition(i);
 		}
 
 		void StickCollectionController::updateStickPosition(int i)
 		{
-			float x_position = (i * sticks[i]->stick_view->getSize().x) + ((i)*collection_model->elements_spacing);
-			float y_position = collection_model->element_y_position - sticks[i]->stick_view->getSize().y;
+			float stick_height = calculateStickHeight(stick_keys[i]);
+
+			float x_position = (i * stick_width) + ((i + 1) * collection_model->elements_spacing);
+			float y_position = collection_model->element_y_position - stick_height;
 
-			sticks[i]->stick_view->setPosition(sf::Vector2f(x_position, y_position));
+			collection_view->setStickRectangle(i, sf::Vector2f(stick_width, stick_height), sf::Vector2f(x_position, y_position));
+			collection_view->setStickColor(i, stick_colors[i]);
 		}
 
-		void StickCollectionController::shuffleSticks()
+		void StickCollectionController::generateSticks()
 		{
+			// A fresh seed per layout; the generator is deterministic, so the bench can rebuild any layout from its seed
 			std::random_device device;
-			std::mt19937 random_engine(device());
+			input_generator->setSeed(device());
+
+			if (input_distribution == Sort::Input::Distribution::DATASET)
+			{
+				// A window of neighbouring keys, so whatever order the data has survives in the sample
+				std::size_t first = static_cast<std::size_t>(std::mt19937_64(input_generator->getSeed())() % (dataset->getNumberOfKeys() - stick_keys.size() + 1));
+				dataset->copyKeys(first, stick_keys.size(), stick_keys.data());
+			}
+			else
+			{
+				input_generator->generate(input_distribution, stick_keys.data(), stick_keys.size());
+			}
 
-			std::shuffle(sticks.begin(), sticks.end(), random_engine);
+			Sort::Input::InputGenerator::fitToRange(stick_keys.data(), stick_keys.size(), static_cast<int>(stick_keys.size()));
 			updateStickPosition();
 		}
 
-		bool StickCollectionController::compareSticksByData(const Stick* a, const Stick* b) const
+		void StickCollectionController::setStickData(int i, int data)
 		{
-			return a->data < b->data;
+			stick_keys[i] = data;
+
+			if (!dirty_sticks[i])
+			{
+				dirty_sticks[i] = true;
+				dirty_stick_indices.push_back(i);
+			}
 		}
 
-		void StickCollectionController::processSortThreadState()
+		void StickCollectionController::setStickColor(int i, sf::Color color)
+		{
+			stick_colors[i] = color;
+			collection_view->setStickColor(i, color);
+		}
+
+		void StickCollectionController::refreshStickViews()
 		{
-			
-			if (sort_thread.joinable() && isCollectionSorted())
+			// Rewrite each changed stick's vertices once per frame, however many operations touched it
+			for (int i : dirty_stick_indices)
 			{
-				sort_thread.join();
-				sort_state = SortState::NOT_SORTING;
+				updateStickPosition(i);
+				dirty_sticks[i] = false;
 			}
+
+			dirty_stick_indices.clear();
 		}
 
+		sf::Color StickCollectionController::getHighlightColor(Sort::HighlightType highlight_type)
+		{
+			switch (highlight_type)
+			{
+			case Sort::HighlightType::PROCESSING:
+				return collection_model->processing_element_color;
+			case Sort::HighlightType::PLACEMENT:
+				return collection_model->placement_position_element_color;
+			case Sort::HighlightType::SELECTED:
+				return collection_model->selected_element_color;
+			case Sort::HighlightType::TEMPORARY:
+				return collection_model->temporary_processing_color;
+			case Sort::HighlightType::LESS:
+				return collection_model->less_element_color;
+			case Sort::HighlightType::GREATER:
+				return collection_model->greater_element_color;
+			default:
+				return collection_model->element_color;
+			}
+		}
+
+		void StickCollectionController::processSortThreadState()
+		{
+			// Read the flag before consuming so the final snapshot is never left behind in the buffer
+			bool is_thread_finished = is_sort_finished.load(std::memory_order_acquire);
+
+			if (snapshot_buffer.consume()) applySnapshot(snapshot_buffer.getReadBuffer());
+
+			if (is_thread_finished && sort_thread.joinable()) sort_thread.join();
+		}
+
+		void StickCollectionController::applySnapshot(const StickCollectionSnapshot& snapshot)
+		{
+			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
+
+			if (!snapshot.keys.empty())
+			{
+				for (int i = 0; i < stick_keys.size(); i++)
+				{
+					if (stick_keys[i] != snapshot.keys[i]) setStickData(i, snapshot.keys[i]);
+					if (stick_colors[i] != snapshot.colors[i]) setStickColor(i, snapshot.colors[i]);
+				}
+				refreshStickViews();
+			}
+
+			cache_statistics = snapshot.cache_statistics;
+			schedule_mode = snapshot.schedule_mode;
+			operations_per_second = snapshot.operations_per_second;
+
+			if (snapshot.play_compare_sound) sound->playSound(Sound::SoundType::COMPARE_SFX);
+
+			// The last COMPLETING snapshot may be overwritten before we see it, so any finished replay counts
+			bool was_replaying = sort_state == SortState::REPLAYING || sort_state == SortState::COMPLETING;
+			if (was_replaying && snapshot.sort_state == SortState::NOT_SORTING) sound->playSound(Sound::SoundType::SCREAM);
+
+			sort_state = snapshot.sort_state;
+		}
 
 		void StickCollectionController::resetSticksColor()
 		{
-			for (int i = 0; i < sticks.size(); i++) sticks[i]->stick_view->setFillColor(collection_model->element_color);
+			for (int i = 0; i < stick_keys.size(); i++) setStickColor(i, collection_model->element_color);
 		}
 
 		void StickCollectionController::resetVariables()
 		{
-			number_of_comparisons = 0;
-			number_of_array_access = 0;
+			operation_counters.reset();
+			cache_statistics = Sort::Metrics::CacheStatistics();
 		}
 
 		void StickCollectionController::reset()
 		{
 			sort_state = SortState::NOT_SORTING;
-			color_delay = 0;
-			current_operation_delay = 0;
-			if (sort_thread.joinable()) sort_thread.join();
+			stopSortThread();
 
-			shuffleSticks();
+			// Drop whatever the cancelled run published last
+			snapshot_buffer.consume();
+			refreshStickViews();
+
+			generateSticks();
 			resetSticksColor();
 			resetVariables();
 		}
 
 		void StickCollectionController::sortElements(SortType sort_type)
 		{
-			current_operation_delay = collection_model->operation_delay;
 			this->sort_type = sort_type;
-			sort_state = SortState::SORTING;
+			sort_state = SortState::RECORDING;
 			color_delay = collection_model->initial_color_delay;
 
 			switch (sort_type)
 			{
 			case Gameplay::Collection::SortType::BUBBLE_SORT:
-				time_complexity = "O(n^2)";
-				sort_thread = std::thread(&StickCollectionController::processBubbleSort, this);
-				break;
 			case Gameplay::Collection::SortType::INSERTION_SORT:
-				time_complexity = "O(n^2)";
-				sort_thread = std::thread(&StickCollectionController::processInsertionSort, this);
-				break;
 			case Gameplay::Collection::SortType::SELECTION_SORT:
 				time_complexity = "O(n^2)";
-				sort_thread = std::thread(&StickCollectionController::processSelectionSort, this);
 				break;
 			case Gameplay::Collection::SortType::MERGE_SORT:
-				time_complexity = "O(n Log n)";
-				sort_thread = std::thread(&StickCollectionController::processMergeSort, this);
-				break;
 			case Gameplay::Collection::SortType::QUICK_SORT:
+			case Gameplay::Collection::SortType::TIM_SORT:
+			case Gameplay::Collection::SortType::HEAP_SORT:
+			case Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT:
+			case Gameplay::Collection::SortType::EXTERNAL_MERGE_SORT:
 				time_complexity = "O(n Log n)";
-				sort_thread = std::thread(&StickCollectionController::processQuickSort, this);
+				break;
+			case Gameplay::Collection::SortType::THREE_WAY_QUICK_SORT:
+				time_complexity = "O(n Log d)";
 				break;
 			case Gameplay::Collection::SortType::RADIX_SORT:
 				time_complexity = "O(w*(n+k))";
-				sort_thread = std::thread(&StickCollectionController::processRadixSort, this);
 				break;
 			}
+
+			sort_keys = stick_keys;
+			resetVariables();
+
+			sort_stop_source = Global::StopSource();
+			is_sort_finished = false;
+			sort_thread = std::thread(&StickCollectionController::processSort, this, sort_stop_source.getToken());
 		}
 
-		bool StickCollectionController::isCollectionSorted()
+		void StickCollectionController::stopSortThread()
 		{
-			for (int i = 1; i < sticks.size(); i++) if (sticks[i] < sticks[i - 1]) return false;
-			return true;
+			// Wakes the sort thread out of any wait and makes the engine bail out at its next operation
+			sort_stop_source.requestStop();
+			if (sort_thread.joinable()) sort_thread.join();
 		}
 
 		void StickCollectionController::destroy()
 		{
-			current_operation_delay = 0;
-			if (sort_thread.joinable()) sort_thread.join();
-
-			for (int i = 0; i < sticks.size(); i++) delete(sticks[i]);
-			sticks.clear();
+			stopSortThread();
 
 			delete (collection_view);
 			delete (collection_model);
+			delete (sort_engine);
+			delete (step_scheduler);
+			delete (trace_recorder);
+			delete (trace_player);
+			delete (input_generator);
+			delete (dataset);
+			delete (memory_model);
 		}
 
-		void StickCollectionController::setCompletedColor()
+		void StickCollectionController::processSort(Global::StopToken stop_token)
 		{
-			for (int k = 0; k < sticks.size(); k++)
-			{
-				if (sort_state == SortState::NOT_SORTING) { break; }
+			recordSort(stop_token);
 
-				sticks[k]->stick_view->setFillColor(collection_model->element_color);
-			}
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-
-			for (int i = 0; i < sticks.size(); ++i)
+			if (!stop_token.isStopRequested() && startReplay())
 			{
-				if (sort_state == SortState::NOT_SORTING) { break; }
-
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
+				processReplay(stop_token);
+				processCompletion(stop_token);
+			}
 
-				// Delay to visualize the final color change
-				std::this_thread::sleep_for(std::chrono::milliseconds(color_delay));
+			trace_player->close();
+			publishSnapshot(SortState::NOT_SORTING);
+			is_sort_finished.store(true, std::memory_order_release);
+		}
 
-			}
-			if (sort_state == SortState::SORTING)
+		void StickCollectionController::recordSort(const Global::StopToken& stop_token)
+		{
+			if (trace_recorder->open(Global::Config::sort_trace_path.toAnsiString(), sort_keys.data(), sort_keys.size(), stop_token))
 			{
-				sound->playSound(Sound::SoundType::SCREAM);
+				sort_engine->sort(sort_type, sort_keys.data(), sort_keys.size());
+				trace_recorder->close();
 			}
 		}
 
-		void StickCollectionController::processBubbleSort()
+		bool StickCollectionController::startReplay()
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
+			if (!trace_player->open(Global::Config::sort_trace_path.toAnsiString()) || trace_player->getNumberOfElements() != stick_keys.size()) return false;
 
-			for (int i = 0;i < sticks.size()-1;i++)
-			{
-				if (sort_state == SortState::NOT_SORTING) break;
-				bool swapped = false;
-				
-				for (int j = 0;j < sticks.size() - 1 - i;j++)
-				{
-					if (sort_state == SortState::NOT_SORTING) break;
-
-					number_of_array_access+=2;number_of_comparisons++;
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
+			replay_keys = trace_player->getInitialKeys();
+			replay_colors.assign(replay_keys.size(), collection_model->element_color);
+			flashed_sticks.clear();
+			compare_sound_played = false;
+			number_of_runs = 0;
+			memory_model->reset(replay_keys.size());
 
-					sticks[j]->stick_view->setFillColor(collection_model->processing_element_color);
-					std::cout << "Data of stick 1 is " << sticks[j]->data << std::endl;
+			applied_replay_speed = -1;
+			applyReplaySpeed();
+			step_scheduler->reset();
+			publishSnapshot(SortState::REPLAYING);
+			return true;
+		}
 
+		void StickCollectionController::processReplay(const Global::StopToken& stop_token)
+		{
+			Sort::SortOperation operation;
 
-					sticks[j + 1]->stick_view->setFillColor(collection_model->processing_element_color);
-					std::cout << "Data of stick 2 is " << sticks[j+1]->data << std::endl;
+			while (!trace_player->isFinished())
+			{
+				applyReplaySpeed();
+				step_scheduler->beginFrame();
 
-					if (sticks[j]->data > sticks[j + 1]->data)
-					{
-						std::swap(sticks[j], sticks[j + 1]);
-						std::cout<<"Swap happened\n";
-						swapped = true;
-					}
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+				// Highlights, phase markers and scratch copies are free, only operations on the sticks use up the frame's steps
+				while (step_scheduler->canStep() && trace_player->next(operation))
+				{
+					applyOperation(operation);
 
-					sticks[j]->stick_view->setFillColor(collection_model->element_color);
-					sticks[j+1]->stick_view->setFillColor(collection_model->element_color);
-					updateStickPosition();
+					bool is_free = operation.type == Sort::OperationType::HIGHLIGHT || operation.type == Sort::OperationType::PHASE || operation.type == Sort::OperationType::AUXILIARY_WRITE;
+					if (!is_free) step_scheduler->step();
 				}
-				std::cout << "Came out of J loop\n";
 
-
-				sticks[sticks.size() - i-1]->stick_view->setFillColor(collection_model->placement_position_element_color);
-
-				if (!swapped)
-					break;
+				publishSnapshot(SortState::REPLAYING);
+				if (stop_token.waitFor(std::chrono::milliseconds(collection_model->publish_interval))) return;
 			}
-			std::cout << "Came out of I loop\n";
-			setCompletedColor();
 		}
 
-		void StickCollectionController::processInsertionSort()
+		void StickCollectionController::applyReplaySpeed()
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
+			int speed = replay_speed.load(std::memory_order_relaxed);
+			if (speed == applied_replay_speed) return;
 
-			for (int i = 1; i < sticks.size(); ++i)
+			const ReplaySpeed& replay_speed_setting = collection_model->replay_speeds[speed];
+			switch (replay_speed_setting.schedule_mode)
 			{
+			case ScheduleMode::OPERATIONS_PER_SECOND:
+				step_scheduler->setOperationsPerSecond(replay_speed_setting.amount);
+				break;
 
-				if (sort_state == SortState::NOT_SORTING) { break; }
-
-				int j = i - 1;
-				Stick* key = sticks[i];
-				number_of_array_access++; // Access for key stick
-
-
-				key->stick_view->setFillColor(collection_model->processing_element_color); // Current key is red
-
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-
-				while (j >= 0 && sticks[j]->data > key->data)
-				{
+			case ScheduleMode::OPERATIONS_PER_FRAME:
+				step_scheduler->setOperationsPerFrame(static_cast<std::uint64_t>(replay_speed_setting.amount));
+				break;
 
-					if (sort_state == SortState::NOT_SORTING) { break; }
+			case ScheduleMode::TIME_BUDGET:
+				step_scheduler->setTimeBudget(static_cast<std::int64_t>(replay_speed_setting.amount));
+				break;
+			}
 
-					number_of_comparisons++;
-					number_of_array_access++;
+			applied_replay_speed = speed;
+		}
 
-					sticks[j + 1] = sticks[j];
-					number_of_array_access++; // Access for assigning sticks[j] to sticks[j + 1]
-					sticks[j + 1]->stick_view->setFillColor(collection_model->processing_element_color); // Mark as being compared
-					j--;
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
-					updateStickPosition(); // Visual update
+		void StickCollectionController::processCompletion(const Global::StopToken& stop_token)
+		{
+			restoreFlashedSticks();
+			replay_colors.assign(replay_keys.size(), collection_model->element_color);
 
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+			sf::Clock completion_clock;
+			float completion_time_budget = 0;
+			int completed_sticks = 0;
 
-					sticks[j + 2]->stick_view->setFillColor(collection_model->selected_element_color); // Mark as being compared
+			while (!stop_token.isStopRequested() && completed_sticks < replay_keys.size())
+			{
+				completion_time_budget += completion_clock.restart().asMilliseconds();
 
+				while (completed_sticks < replay_keys.size() && completion_time_budget >= 0)
+				{
+					replay_colors[completed_sticks++] = collection_model->placement_position_element_color;
+					completion_time_budget -= color_delay;
 				}
 
-				sticks[j + 1] = key;
-				number_of_array_access++;
-				sticks[j + 1]->stick_view->setFillColor(collection_model->temporary_processing_color); // Placed key is green indicating it's sorted
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				updateStickPosition(); // Final visual update for this iteration
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				sticks[j + 1]->stick_view->setFillColor(collection_model->selected_element_color); // Placed key is green indicating it's sorted
+				compare_sound_played = true;
+				publishSnapshot(SortState::COMPLETING);
+				if (stop_token.waitFor(std::chrono::milliseconds(collection_model->publish_interval))) return;
 			}
-
-			setCompletedColor();
 		}
 
-		void StickCollectionController::processSelectionSort()
+		void StickCollectionController::applyOperation(const Sort::SortOperation& operation)
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-			
-			for (int i = 0;i < sticks.size()-1;i++)
-			{
-				if (sort_state == SortState::NOT_SORTING) { break; }
+			int first = static_cast<int>(operation.first);
+			int second = static_cast<int>(operation.second);
 
-				int minIndex = i;
-				sticks[i]->stick_view->setFillColor(collection_model->selected_element_color);
-
-				for (int j = i+1;j < sticks.size();j++)
-				{
-					if (sort_state == SortState::NOT_SORTING) { break; }
+			operation_counters.count(operation);
+			if (collection_model->is_cache_model_enabled) memory_model->access(operation);
 
-					number_of_array_access += 2;
-					number_of_comparisons++;
+			if (operation.type != Sort::OperationType::PHASE) restoreFlashedSticks();
 
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
-					
-					sticks[j]->stick_view->setFillColor(collection_model->processing_element_color);
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-
-					
+			switch (operation.type)
+			{
+			case Sort::OperationType::COMPARE:
+				flashStick(first);
+				flashStick(second);
+				compare_sound_played = true;
+				break;
 
-					if (sticks[j]->data < sticks[minIndex]->data)
-					{
-						if(minIndex!=i)
-							sticks[minIndex]->stick_view->setFillColor(collection_model->element_color);
+			case Sort::OperationType::SWAP:
+				std::swap(replay_keys[first], replay_keys[second]);
+				break;
 
-						minIndex = j;
-						sticks[minIndex]->stick_view->setFillColor(collection_model->temporary_processing_color);
-					}
-					else
-						sticks[j]->stick_view->setFillColor(collection_model->element_color);
-				}
+			case Sort::OperationType::MOVE:
+				replay_keys[second] = replay_keys[first];
+				break;
 
-				number_of_array_access += 3;//for swapping
+			case Sort::OperationType::WRITE:
+				replay_keys[first] = operation.value;
+				break;
 
-				Stick* temp = sticks[i];
-				sticks[i] = sticks[minIndex];
-				sticks[minIndex] = temp;
+			case Sort::OperationType::READ:
+				flashStick(first);
+				break;
 
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
+			case Sort::OperationType::HIGHLIGHT:
+				replay_colors[first] = getHighlightColor(static_cast<Sort::HighlightType>(operation.value));
+				break;
 
-				updateStickPosition();
+			case Sort::OperationType::PHASE:
+				if (static_cast<Sort::PhaseType>(operation.value) == Sort::PhaseType::RUN) colorRun(first, second);
+				else if (static_cast<Sort::PhaseType>(operation.value) == Sort::PhaseType::HEAP) colorHeap(first, second);
+				break;
 
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
+			case Sort::OperationType::AUXILIARY_WRITE:
+				break;
 			}
-			setCompletedColor();
 		}
 
-		void StickCollectionController::processInPlaceMergeSort()
+		void StickCollectionController::flashStick(int i)
 		{
-			inPlaceMergeSort(0, sticks.size() - 1);
-
-			setCompletedColor();
+			flashed_sticks.push_back(std::make_pair(i, replay_colors[i]));
+			replay_colors[i] = collection_model->processing_element_color;
 		}
 
-		void StickCollectionController::processMergeSort()
+		void StickCollectionController::restoreFlashedSticks()
 		{
-			outPlaceMergeSort(0, sticks.size() - 1);
+			for (int i = static_cast<int>(flashed_sticks.size()) - 1; i >= 0; i--)
+				replay_colors[flashed_sticks[i].first] = flashed_sticks[i].second;
 
-			setCompletedColor();
+			flashed_sticks.clear();
 		}
 
-		void StickCollectionController::processQuickSort()
+		void StickCollectionController::colorRun(int begin, int end)
 		{
-			quickSort(0, sticks.size() - 1);
-
-			setCompletedColor();
+			colorRange(begin, end, collection_model->run_colors[number_of_runs++ % 2]);
 		}
 
-		void StickCollectionController::processRadixSort()
+		// Stripes the heap by level, the root alone, then its children, their children and so on
+		void StickCollectionController::colorHeap(int begin, int end)
 		{
-			radixSort();
+			// The quick sort's depth-limit fallback always builds a binary heap
+			int arity = sort_type == SortType::HEAP_SORT ? static_cast<int>(sort_engine->getHeapArity()) : 2;
+			int level_begin = begin;
+			int level_size = 1;
 
-			setCompletedColor();
-		}
-
-		void StickCollectionController::inPlaceMerge(int left, int mid, int right)
-		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-
-			int i = left;
-			int j = mid + 1;
-			int k = left;
-
-			while (i <= mid && j <= right)
+			for (int level = 0; level_begin < end; level++)
 			{
-				if (sticks[i]->data <= sticks[j]->data)
-				{
-					i++;
-					k++;
+				int level_end = std::min(level_begin + level_size, end);
+				colorRange(level_begin, level_end, collection_model->heap_level_colors[level % 2]);
 
-					number_of_array_access += 2;
-					number_of_comparisons++;
-				}
-				else
-				{
-					Stick* temp = sticks[j];
-					for (int l = j; l > k; l--)
-					{
-						sticks[l] = sticks[l - 1];
-						number_of_array_access += 2;
-					}
-					sticks[k] = temp;number_of_array_access++;
-					i++;
-					mid++;
-					j++;
-					k++;
-
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
-					updateStickPosition();
-
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				}
+				level_begin = level_end;
+				level_size *= arity;
 			}
 		}
 
-		void StickCollectionController::inPlaceMergeSort(int left, int right)
+		void StickCollectionController::colorRange(int begin, int end, sf::Color color)
 		{
-			if (left < right)
-			{
-				int mid = left + (right - left) / 2;
-				inPlaceMergeSort(left, mid);
-				inPlaceMergeSort(mid + 1, right);
-				inPlaceMerge(left, mid, right);
-			}
-			else
-				return;
-		}
+			for (int i = begin; i < end; i++) replay_colors[i] = color;
 
-		void StickCollectionController::outPlaceMergeSort(int left, int right)
-		{
-			
-			if (left < right)
-			{
-				int mid = left + (right - left) / 2;
-				outPlaceMergeSort(left, mid);
-				outPlaceMergeSort(mid + 1, right);
-				outPlaceMerge(left, mid, right);
-			}
+			// Sticks still flashing from the comparisons that found the range go back to its color
+			for (std::pair<int, sf::Color>& flashed_stick : flashed_sticks)
+				if (flashed_stick.first >= begin && flashed_stick.first < end) flashed_stick.second = color;
 		}
 
-		void StickCollectionController::outPlaceMerge(int left, int mid, int right)
+		void StickCollectionController::publishSnapshot(SortState state)
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-			
-			int size = right - left + 1;
-			std::vector<Stick*> temp(right - left + 1);
-
-			int i = left;int j = mid + 1;int k = 0;
-
-			// Copy elements to the temporary array
-			for (int index = left; index <= right; ++index) {
-				temp[k++] = sticks[index];
-				number_of_array_access += 2;//two
-				sticks[index]->stick_view->setFillColor(collection_model->temporary_processing_color);
-				updateStickPosition();
-			}
-
-			i = 0;  // Start of the first half in temp
-			j = mid - left + 1;  // Start of the second half in temp
-			k = left;  // Start position in the original array to merge back
-
-			// Merge elements back to the original array from temp
-			while (i < mid - left + 1 && j < temp.size()) {
-				if (temp[i]->data <= temp[j]->data) {
-					sticks[k] = temp[i++];
-				}
-				else {
-					sticks[k] = temp[j++];
-				}
-				number_of_array_access += 2;number_of_comparisons++;
-
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();  // Immediate update after assignment
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-
-				k++;
-
-			}
-
-			// Handle remaining elements from both halves
-			while (i < mid - left + 1 || j < temp.size()) {
-				if (i < mid - left + 1) {
-					sticks[k] = temp[i++];
-				}
-				else {
-					sticks[k] = temp[j++];
-				}
-				number_of_array_access += 2;number_of_comparisons++;
-
-				sound->playSound(Sound::SoundType::COMPARE_SFX);
-				sticks[k]->stick_view->setFillColor(collection_model->processing_element_color);
-				updateStickPosition();  // Immediate update
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-
-				k++;
-			}
+			StickCollectionSnapshot& snapshot = snapshot_buffer.getWriteBuffer();
 
+			snapshot.keys = replay_keys;
+			snapshot.colors = replay_colors;
+			snapshot.sort_state = state;
+			snapshot.cache_statistics = memory_model->getStatistics();
+			snapshot.schedule_mode = step_scheduler->getScheduleMode();
+			snapshot.operations_per_second = step_scheduler->getOperationsPerSecond();
+			snapshot.play_compare_sound = compare_sound_played;
 
+			snapshot_buffer.publish();
+			compare_sound_played = false;
 		}
 
-		void StickCollectionController::quickSort(int low, int high)
+		void StickCollectionController::setInputDistribution(Sort::Input::Distribution distribution)
 		{
-			if (low < high) 
-			{
-				int pivot = partition(low, high);
-				quickSort(low, pivot - 1);
-				quickSort(pivot + 1, high);
-			}
-
-			for (int i = low; i <= high; i++) 
-			{
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);
-				updateStickPosition();
-			}
+			input_distribution = distribution;
+			if (sort_state == SortState::NOT_SORTING) generateSticks();
 		}
 
-		int StickCollectionController::partition(int low, int high)
+		void StickCollectionController::cycleReplaySpeed()
 		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-			
-			int pivot_data = sticks[high]->data;
-			sticks[high]->stick_view->setFillColor(collection_model->selected_element_color);
-			
-			int swap_marker = low - 1;
-
-			for (int j = low;j < high;j++)
-			{
-				sticks[j]->stick_view->setFillColor(collection_model->processing_element_color);
-				number_of_array_access += 2;
-				number_of_comparisons++;
-				
-				if (sticks[j]->data < pivot_data)
-				{
-					swap_marker++;
-
-					Stick* temp = sticks[swap_marker];
-					sticks[swap_marker] = sticks[j];
-					sticks[j] = temp;
-
-					number_of_array_access += 3;
-					sound->playSound(Sound::SoundType::COMPARE_SFX);
-
-					updateStickPosition();
-					std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay));
-				}
-
-				sticks[j]->stick_view->setFillColor(collection_model->element_color);
-			}
-
-			Stick* temp = sticks[swap_marker + 1];
-			sticks[swap_marker + 1] = sticks[high];
-			sticks[high] = temp;
-
-			number_of_array_access += 3;
-
-			updateStickPosition();
-
-			return swap_marker + 1;
-		}
-
-		void StickCollectionController::radixSort()
-		{
-			int max = sticks[0]->data;
-
-			for (int i = 1;i < sticks.size();i++)
-			{
-				if (sticks[i]->data > max)
-				{
-					max = sticks[i]->data;
-				}
-			}
-
-			for (int exp = 1;max / exp > 0;exp *= 10)
-			{
-				countSort(exp);
-			}
+			replay_speed = (replay_speed.load() + 1) % StickCollectionModel::number_of_replay_speeds;
 		}
 
-		void StickCollectionController::countSort(int exponent)
-		{
-			Sound::SoundService* sound = Global::ServiceLocator::getInstance()->getSoundService();
-
-			int count[10] = { 0 };
-			std::vector<Stick*> output(sticks.size());
-
-			for (int i = 0;i < sticks.size();i++)//making the count array
-			{
-				int digit = (sticks[i]->data / exponent) % 10;
-				count[digit]++;
-
-				number_of_array_access++;
-
-				sticks[i]->stick_view->setFillColor(collection_model->processing_element_color);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay / 2)); // Delay for visual processing
-				sticks[i]->stick_view->setFillColor(collection_model->element_color);  // Reset color after processing
-			}
+		SortType StickCollectionController::getSortType() { return sort_type; }
 
-			for (int i = 1;i < 10;i++)//making count cumulatibe
-			{
-				count[i] += count[i - 1];
-			}
+		Sort::Input::Distribution StickCollectionController::getInputDistribution() { return input_distribution; }
 
-			for (int i = sticks.size() - 1;i >= 0;i--)//putting the elements in the output array
-			{
-				int digit = (sticks[i]->data / exponent) % 10;
+		bool StickCollectionController::hasDataset() { return dataset->isOpen(); }
 
-				output[count[digit] - 1] = sticks[i];
-				output[count[digit] - 1]->stick_view->setFillColor(collection_model->temporary_processing_color);
-				count[digit]--;
-				number_of_array_access++;
-			}
+		int StickCollectionController::getNumberOfComparisons() { return static_cast<int>(operation_counters.read().get(Sort::Metrics::CounterType::COMPARISONS)); }
 
-			for (int i = 0;i < sticks.size();i++)//copying the output array to the original array
-			{
-				sticks[i] = output[i];
+		int StickCollectionController::getNumberOfArrayAccess() { return static_cast<int>(operation_counters.read().getArrayAccess()); }
 
-				sticks[i]->stick_view->setFillColor(collection_model->placement_position_element_color);  // Final sorted color for this digit
-				updateStickPosition(i);
-				std::this_thread::sleep_for(std::chrono::milliseconds(current_operation_delay)); // Delay to observe final sorting stat
-			}
-		}
+		bool StickCollectionController::isCacheModelEnabled() { return collection_model->is_cache_model_enabled; }
 
-		SortType StickCollectionController::getSortType() { return sort_type; }
+		const Sort::Metrics::CacheStatistics& StickCollectionController::getCacheStatistics() { return cache_statistics; }
 
-		int StickCollectionController::getNumberOfComparisons() { return number_of_comparisons; }
+		int StickCollectionController::getNumberOfSticks() { return collection_model->number_of_elements; }
 
-		int StickCollectionController::getNumberOfArrayAccess() { return number_of_array_access; }
+		const char* StickCollectionController::getReplaySpeedTitle() { return collection_model->replay_speeds[replay_speed.load()].title; }
 
-		int StickCollectionController::getNumberOfSticks() { return collection_model->number_of_elements; }
+		ScheduleMode StickCollectionController::getScheduleMode() { return schedule_mode; }
 
-		int StickCollectionController::getDelayMilliseconds() { return current_operation_delay; }
+		int StickCollectionController::getOperationsPerSecond() { return static_cast<int>(operations_per_second + 0.5); }
 
 		sf::String StickCollectionController::getTimeComplexity() { return time_complexity; }
 	}
@@ -1,28 +1,46 @@
 #include "Gameplay/Collection/StickCollectionView.h"
+#include "Gameplay/Collection/StickCollectionController.h"
 
 namespace Gameplay {
 	namespace Collection {
 
+		using namespace UI::UIElement;
+
 		StickCollectionView::StickCollectionView()
 		{
+			sticks_batch_view = new RectangleBatchView();
 		}
 
 		StickCollectionView::~StickCollectionView()
 		{
+			delete (sticks_batch_view);
 		}
 
 		void StickCollectionView::initialize(StickCollectionController* collection_controller)
 		{
 			this->collection_controller = collection_controller;
+			sticks_batch_view->initialize(collection_controller->getNumberOfSticks());
 		}
 
 		void StickCollectionView::update()
 		{
+			sticks_batch_view->update();
 		}
 
 		void StickCollectionView::render()
 		{
+			sticks_batch_view->render();
+		}
+
+		void StickCollectionView::setStickRectangle(int index, sf::Vector2f stick_size, sf::Vector2f stick_position)
+		{
+			sticks_batch_view->setRectangle(index, stick_size, stick_position);
+		}
+
+		void StickCollectionView::setStickColor(int index, sf::Color stick_color)
+		{
+			sticks_batch_view->setFillColor(index, stick_color);
 		}
 
 	}
-}
\ No newline at end of file
+}
@@ -48,11 +48,31 @@ namespace Gameplay
 		collection_controller->sortElements(sort_type);
 	}
 
+	void GameplayService::setInputDistribution(Sort::Input::Distribution distribution)
+	{
+		collection_controller->setInputDistribution(distribution);
+	}
+
+	void GameplayService::cycleReplaySpeed()
+	{
+		collection_controller->cycleReplaySpeed();
+	}
+
 	Collection::SortType GameplayService::getSortType()
 	{
 		return collection_controller->getSortType();
 	}
 
+	Sort::Input::Distribution GameplayService::getInputDistribution()
+	{
+		return collection_controller->getInputDistribution();
+	}
+
+	bool GameplayService::hasDataset()
+	{
+		return collection_controller->hasDataset();
+	}
+
 	int GameplayService::getNumberOfComparisons()
 	{
 		return collection_controller->getNumberOfComparisons();
@@ -63,14 +83,34 @@ namespace Gameplay
 		return collection_controller->getNumberOfArrayAccess();
 	}
 
+	bool GameplayService::isCacheModelEnabled()
+	{
+		return collection_controller->isCacheModelEnabled();
+	}
+
+	const Sort::Metrics::CacheStatistics& GameplayService::getCacheStatistics()
+	{
+		return collection_controller->getCacheStatistics();
+	}
+
 	int GameplayService::getNumberOfSticks()
 	{
 		return collection_controller->getNumberOfSticks();
 	}
 
-	int GameplayService::getDelayMilliseconds()
+	const char* GameplayService::getReplaySpeedTitle()
+	{
+		return collection_controller->getReplaySpeedTitle();
+	}
+
+	Collection::ScheduleMode GameplayService::getScheduleMode()
+	{
+		return collection_controller->getScheduleMode();
+	}
+
+	int GameplayService::getOperationsPerSecond()
 	{
-		return collection_controller->getDelayMilliseconds();
+		return collection_controller->getOperationsPerSecond();
 	}
 
 	sf::String GameplayService::getTimeComplexity()
@@ -31,4 +31,8 @@ namespace Global
 	const sf::String Config::button_click_sound_path = "assets/sounds/button_click_sound.wav";
 
 	const sf::String Config::scream_sound_path = "assets/sounds/scream.mp3";
+
+	const sf::String Config::sort_trace_path = "sort_trace.bin";
+	const sf::String Config::external_sort_path = "sort_external";
+	const sf::String Config::stick_dataset_path = "assets/datasets/sticks.bin";
 }
\ No newline at end of file
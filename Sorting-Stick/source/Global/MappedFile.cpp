@@ -0,0 +1,132 @@
+#include "Global/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Global
+{
+	MappedFile::MappedFile()
+	{
+		data = nullptr;
+		size = 0;
+
+#ifdef _WIN32
+		file_handle = INVALID_HANDLE_VALUE;
+		mapping_handle = nullptr;
+#else
+		file_descriptor = -1;
+#endif
+	}
+
+	MappedFile::~MappedFile() { close(); }
+
+#ifdef _WIN32
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+
+		file_handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_handle == INVALID_HANDLE_VALUE) return false;
+
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file_handle, &file_size))
+		{
+			close();
+			return false;
+		}
+
+		size = static_cast<std::size_t>(file_size.QuadPart);
+		if (size == 0) return true;
+
+		mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_handle)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const unsigned char*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+		if (!data)
+		{
+			close();
+			return false;
+		}
+
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (data) UnmapViewOfFile(data);
+		if (mapping_handle) CloseHandle(mapping_handle);
+		if (file_handle != INVALID_HANDLE_VALUE) CloseHandle(file_handle);
+
+		data = nullptr;
+		size = 0;
+		mapping_handle = nullptr;
+		file_handle = INVALID_HANDLE_VALUE;
+	}
+
+	// FILE_FLAG_SEQUENTIAL_SCAN at open already tells the cache manager to read ahead.
+	void MappedFile::adviseSequential() { }
+
+	bool MappedFile::isOpen() const { return file_handle != INVALID_HANDLE_VALUE; }
+#else
+	bool MappedFile::open(const std::string& path)
+	{
+		close();
+
+		file_descriptor = ::open(path.c_str(), O_RDONLY);
+		if (file_descriptor < 0) return false;
+
+		struct stat file_status;
+		if (fstat(file_descriptor, &file_status) != 0)
+		{
+			close();
+			return false;
+		}
+
+		size = static_cast<std::size_t>(file_status.st_size);
+		if (size == 0) return true;
+
+		void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+		if (mapping == MAP_FAILED)
+		{
+			close();
+			return false;
+		}
+
+		data = static_cast<const unsigned char*>(mapping);
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (data) munmap(const_cast<unsigned char*>(data), size);
+		if (file_descriptor >= 0) ::close(file_descriptor);
+
+		data = nullptr;
+		size = 0;
+		file_descriptor = -1;
+	}
+
+	void MappedFile::adviseSequential()
+	{
+		if (data) madvise(const_cast<unsigned char*>(data), size, MADV_SEQUENTIAL);
+	}
+
+	bool MappedFile::isOpen() const { return file_descriptor >= 0; }
+#endif
+
+	const unsigned char* MappedFile::getData() const { return data; }
+
+	std::size_t MappedFile::getSize() const { return size; }
+}
@@ -0,0 +1,336 @@
+#include "Sort/External/ExternalMergeSort.h"
+#include "Sort/SortEngine.h"
+#include "Sort/LoserTree.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <future>
+
+namespace Sort
+{
+	namespace External
+	{
+		namespace
+		{
+			// Moves the operations of a run's in-memory sort to the run's place in the input
+			class RunSink : public Interface::IOperationSink
+			{
+			private:
+				Interface::IOperationSink* operation_sink;
+				std::size_t offset;
+
+			public:
+				RunSink(Interface::IOperationSink* operation_sink, std::size_t offset) : operation_sink(operation_sink), offset(offset) { }
+
+				void onOperation(const SortOperation& operation) override
+				{
+					SortOperation shifted = operation;
+					shifted.first += offset;
+
+					if (operation.type != OperationType::WRITE && operation.type != OperationType::READ && operation.type != OperationType::HIGHLIGHT) shifted.second += offset;
+					operation_sink->onOperation(shifted);
+				}
+
+				bool isCancelled() override { return operation_sink->isCancelled(); }
+			};
+		}
+
+		// Compares the next keys of two runs, shown at the runs' places in the input
+		struct ExternalMergeSort::HeadLess
+		{
+			ExternalMergeSort* external_merge_sort;
+			const std::vector<std::unique_ptr<MergeInput>>* inputs;
+
+			bool operator()(std::size_t a, std::size_t b) const
+			{
+				const MergeInput& first = *(*inputs)[a];
+				const MergeInput& second = *(*inputs)[b];
+
+				if (external_merge_sort->operation_sink) external_merge_sort->report(OperationType::COMPARE, first.position, second.position, 0);
+				return first.reader.peek() < second.reader.peek();
+			}
+		};
+
+		ExternalMergeSort::ExternalMergeSort()
+		{
+			memory_budget = std::size_t(256) << 20;
+			max_fan_in = 128;
+			run_sort_type = SortType::QUICK_SORT;
+			run_engine = new SortEngine();
+			io_queue = new IoQueue();
+			operation_sink = nullptr;
+		}
+
+		ExternalMergeSort::~ExternalMergeSort()
+		{
+			delete io_queue;
+			delete run_engine;
+		}
+
+		void ExternalMergeSort::setMemoryBudget(std::size_t bytes) { memory_budget = bytes; }
+
+		void ExternalMergeSort::setMaxFanIn(std::size_t runs) { max_fan_in = std::max<std::size_t>(2, runs); }
+
+		// An external run sort would go back to disk for every run
+		void ExternalMergeSort::setRunSortType(SortType sort_type) { run_sort_type = sort_type == SortType::EXTERNAL_MERGE_SORT ? SortType::QUICK_SORT : sort_type; }
+
+		void ExternalMergeSort::setNumberOfThreads(unsigned threads) { run_engine->setNumberOfThreads(threads); }
+
+		void ExternalMergeSort::setOperationSink(Interface::IOperationSink* sink) { operation_sink = sink; }
+
+		const std::string& ExternalMergeSort::getError() const { return error; }
+
+		bool ExternalMergeSort::sort(const std::string& input_path, const std::string& output_path)
+		{
+			error.clear();
+
+			std::vector<Run> runs;
+			if (!formRuns(input_path, output_path + ".run", runs))
+			{
+				removeRuns(runs);
+				return false;
+			}
+
+			// Too many runs to merge in one go are merged in groups into fewer, longer runs first
+			for (int pass = 0; runs.size() > max_fan_in; pass++)
+			{
+				std::vector<Run> merged_runs;
+
+				for (std::size_t first = 0; first < runs.size(); first += max_fan_in)
+				{
+					std::vector<Run> group(runs.begin() + first, runs.begin() + std::min(first + max_fan_in, runs.size()));
+
+					Run merged_run;
+					merged_run.path = output_path + ".pass" + std::to_string(pass) + ".run" + std::to_string(merged_runs.size());
+					merged_run.begin = group.front().begin;
+					merged_run.size = group.back().begin + group.back().size - merged_run.begin;
+					merged_runs.push_back(merged_run);
+
+					if (!mergeRuns(group, merged_run.path, false))
+					{
+						removeRuns(merged_runs);
+						removeRuns(std::vector<Run>(runs.begin() + first, runs.end()));
+						return false;
+					}
+
+					removeRuns(group);
+				}
+
+				runs.swap(merged_runs);
+			}
+
+			bool is_sorted = mergeRuns(runs, output_path, true);
+			removeRuns(runs);
+
+			return is_sorted;
+		}
+
+		bool ExternalMergeSort::formRuns(const std::string& input_path, const std::string& run_path, std::vector<Run>& runs)
+		{
+			std::ifstream input(input_path, std::ios::binary);
+			if (!input.is_open())
+			{
+				error = "cannot open " + input_path;
+				return false;
+			}
+
+			// Three buffers rotate so that while one run is sorted, the last one is written from the second buffer
+			// and then the next one read into the third; a buffer is reused once the run written from it is on disk
+			std::size_t run_keys = std::max<std::size_t>(1, memory_budget / (number_of_buffers * sizeof(int)));
+			std::vector<int> buffers[number_of_buffers];
+			for (std::vector<int>& buffer : buffers) buffer.resize(run_keys);
+
+			auto readRun = [&input, run_keys](int* buffer)
+			{
+				input.read(reinterpret_cast<char*>(buffer), run_keys * sizeof(int));
+				return static_cast<std::size_t>(input.gcount()) / sizeof(int);
+			};
+
+			std::future<std::size_t> pending_writes[number_of_buffers];
+			std::size_t written_runs[number_of_buffers] = {};
+			auto finishWrite = [this, &pending_writes, &written_runs, &runs](int buffer)
+			{
+				if (!pending_writes[buffer].valid() || pending_writes[buffer].get() == runs[written_runs[buffer]].size) return true;
+
+				error = "cannot write " + runs[written_runs[buffer]].path;
+				return false;
+			};
+
+			auto finishWrites = [&finishWrite]()
+			{
+				bool is_written = true;
+				for (int buffer = 0; buffer < number_of_buffers; buffer++) is_written = finishWrite(buffer) && is_written;
+				return is_written;
+			};
+
+			std::future<std::size_t> pending_read = io_queue->submit(std::bind(readRun, buffers[0].data()));
+			std::size_t begin = 0;
+			int current = 0;
+
+			while (true)
+			{
+				std::size_t size = pending_read.get();
+				if (size == 0) break;
+
+				int next = (current + 1) % number_of_buffers;
+				if (!finishWrite(next))
+				{
+					finishWrites();
+					return false;
+				}
+
+				pending_read = io_queue->submit(std::bind(readRun, buffers[next].data()));
+
+				sortRun(buffers[current].data(), size, begin);
+
+				Run run;
+				run.path = run_path + std::to_string(runs.size());
+				run.begin = begin;
+				run.size = size;
+				written_runs[current] = runs.size();
+				runs.push_back(run);
+
+				const int* keys = buffers[current].data();
+				pending_writes[current] = io_queue->submit([run, keys]()
+				{
+					std::ofstream stream(run.path, std::ios::binary | std::ios::trunc);
+					stream.write(reinterpret_cast<const char*>(keys), run.size * sizeof(int));
+					stream.close();
+					return stream.fail() ? std::size_t(0) : run.size;
+				});
+
+				begin += size;
+				current = next;
+
+				if (isCancelled())
+				{
+					pending_read.wait();
+					finishWrites();
+					error = "cancelled";
+					return false;
+				}
+			}
+
+			if (!finishWrites()) return false;
+
+			if (input.bad())
+			{
+				error = "cannot read " + input_path;
+				return false;
+			}
+
+			return true;
+		}
+
+		void ExternalMergeSort::sortRun(int* keys, std::size_t size, std::size_t begin)
+		{
+			if (!operation_sink)
+			{
+				run_engine->setOperationSink(nullptr);
+				run_engine->sort(run_sort_type, keys, size);
+				return;
+			}
+
+			RunSink run_sink(operation_sink, begin);
+			run_engine->setOperationSink(&run_sink);
+			run_engine->sort(run_sort_type, keys, size);
+			run_engine->setOperationSink(nullptr);
+
+			report(OperationType::PHASE, begin, begin + size, static_cast<int>(PhaseType::RUN));
+		}
+
+		bool ExternalMergeSort::mergeRuns(const std::vector<Run>& runs, const std::string& output_path, bool is_output)
+		{
+			// Every run and the output get two blocks each out of the budget
+			std::size_t block_keys = std::max<std::size_t>(1, memory_budget / (2 * sizeof(int) * (runs.size() + 1)));
+
+			std::vector<std::unique_ptr<MergeInput>> inputs;
+			for (const Run& run : runs)
+			{
+				inputs.emplace_back(new MergeInput());
+				inputs.back()->position = run.begin;
+
+				if (!inputs.back()->reader.open(run.path, block_keys, io_queue))
+				{
+					error = "cannot read " + run.path;
+					return false;
+				}
+			}
+
+			RunWriter writer;
+			if (!writer.open(output_path, block_keys, io_queue))
+			{
+				error = "cannot write " + output_path;
+				return false;
+			}
+
+			HeadLess head_less = { this, &inputs };
+			LoserTree<HeadLess> loser_tree(head_less);
+
+			loser_tree.reset(inputs.size());
+			for (std::size_t run = 0; run < inputs.size(); run++) if (inputs[run]->reader.isEmpty()) loser_tree.markExhausted(run);
+			loser_tree.build();
+
+			std::size_t output_position = runs.empty() ? 0 : runs.front().begin;
+
+			while (!loser_tree.isEmpty())
+			{
+				std::size_t run = loser_tree.top();
+				MergeInput& input = *inputs[run];
+				int key = input.reader.peek();
+
+				if (operation_sink)
+				{
+					report(OperationType::READ, input.position);
+					if (is_output) report(OperationType::WRITE, output_position, 0, key);
+					if (isCancelled())
+					{
+						error = "cancelled";
+						return false;
+					}
+				}
+
+				writer.push(key);
+				output_position++;
+				input.position++;
+				input.reader.pop();
+
+				if (!input.reader.isEmpty())
+				{
+					loser_tree.replay();
+				}
+				else if (input.reader.isFailed())
+				{
+					error = "cannot read " + runs[run].path;
+					return false;
+				}
+				else
+				{
+					loser_tree.pop();
+				}
+			}
+
+			if (!writer.close())
+			{
+				error = "cannot write " + output_path;
+				return false;
+			}
+
+			return true;
+		}
+
+		void ExternalMergeSort::report(OperationType type, std::size_t first, std::size_t second, int value)
+		{
+			SortOperation operation = { type, first, second, value };
+			operation_sink->onOperation(operation);
+		}
+
+		bool ExternalMergeSort::isCancelled() { return operation_sink && operation_sink->isCancelled(); }
+
+		void ExternalMergeSort::removeRuns(const std::vector<Run>& runs)
+		{
+			for (const Run& run : runs) std::remove(run.path.c_str());
+		}
+	}
+}
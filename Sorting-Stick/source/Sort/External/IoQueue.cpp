@@ -0,0 +1,59 @@
+#include "Sort/External/IoQueue.h"
+
+namespace Sort
+{
+	namespace External
+	{
+		IoQueue::IoQueue()
+		{
+			is_stopping = false;
+			worker = std::thread(&IoQueue::run, this);
+		}
+
+		IoQueue::~IoQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				is_stopping = true;
+			}
+
+			job_available.notify_one();
+			worker.join();
+		}
+
+		std::future<std::size_t> IoQueue::submit(std::function<std::size_t()> job)
+		{
+			std::packaged_task<std::size_t()> task(std::move(job));
+			std::future<std::size_t> result = task.get_future();
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs.push_back(std::move(task));
+			}
+
+			job_available.notify_one();
+			return result;
+		}
+
+		void IoQueue::run()
+		{
+			while (true)
+			{
+				std::packaged_task<std::size_t()> task;
+
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					job_available.wait(lock, [this]() { return is_stopping || !jobs.empty(); });
+
+					// Jobs still queued are finished first, their buffers are waited on by someone
+					if (jobs.empty()) return;
+
+					task = std::move(jobs.front());
+					jobs.pop_front();
+				}
+
+				task();
+			}
+		}
+	}
+}
@@ -0,0 +1,133 @@
+#include "Sort/External/RunFile.h"
+
+namespace Sort
+{
+	namespace External
+	{
+		RunReader::RunReader()
+		{
+			io_queue = nullptr;
+			block_keys = 0;
+			current_block = 0;
+			position = 0;
+			count = 0;
+			is_read_failed = false;
+			is_failed = false;
+		}
+
+		RunReader::~RunReader() { close(); }
+
+		bool RunReader::open(const std::string& path, std::size_t block_keys, IoQueue* io_queue)
+		{
+			close();
+
+			stream.open(path, std::ios::binary);
+			if (!stream.is_open()) return false;
+
+			this->block_keys = block_keys;
+			this->io_queue = io_queue;
+			blocks[0].resize(block_keys);
+			blocks[1].resize(block_keys);
+
+			// The first block is read into 0, then 1 is started while 0 is consumed
+			current_block = 1;
+			readAhead();
+			nextBlock();
+
+			return !isFailed();
+		}
+
+		void RunReader::close()
+		{
+			if (pending_read.valid()) pending_read.wait();
+			if (stream.is_open()) stream.close();
+
+			position = 0;
+			count = 0;
+			is_read_failed = false;
+			is_failed = false;
+		}
+
+		// The stream belongs to the IO thread while a read is queued, so this only reads what the last finished read left
+		bool RunReader::isFailed() const { return is_failed; }
+
+		void RunReader::readAhead()
+		{
+			int* block = blocks[current_block ^ 1].data();
+
+			pending_read = io_queue->submit([this, block]()
+			{
+				stream.read(reinterpret_cast<char*>(block), block_keys * sizeof(int));
+				is_read_failed = stream.bad();
+				return static_cast<std::size_t>(stream.gcount()) / sizeof(int);
+			});
+		}
+
+		void RunReader::nextBlock()
+		{
+			count = pending_read.get();
+			is_failed = is_failed || is_read_failed;
+			position = 0;
+			current_block ^= 1;
+
+			// The block just consumed takes the read after this one; an empty read is the end of the file
+			if (count > 0) readAhead();
+		}
+
+		RunWriter::RunWriter()
+		{
+			io_queue = nullptr;
+			block_keys = 0;
+			current_block = 0;
+			count = 0;
+		}
+
+		RunWriter::~RunWriter() { close(); }
+
+		bool RunWriter::open(const std::string& path, std::size_t block_keys, IoQueue* io_queue)
+		{
+			close();
+
+			stream.open(path, std::ios::binary | std::ios::trunc);
+			if (!stream.is_open()) return false;
+
+			this->block_keys = block_keys;
+			this->io_queue = io_queue;
+			blocks[0].resize(block_keys);
+			blocks[1].resize(block_keys);
+			current_block = 0;
+			count = 0;
+
+			return true;
+		}
+
+		bool RunWriter::close()
+		{
+			if (!stream.is_open()) return true;
+
+			if (count > 0) writeBehind();
+			if (pending_write.valid()) pending_write.get();
+
+			stream.close();
+			return !stream.fail();
+		}
+
+		void RunWriter::writeBehind()
+		{
+			// The other block is refilled next, so its write has to be done
+			if (pending_write.valid()) pending_write.get();
+
+			const int* block = blocks[current_block].data();
+			std::size_t size = count;
+
+			pending_write = io_queue->submit([this, block, size]()
+			{
+				stream.write(reinterpret_cast<const char*>(block), size * sizeof(int));
+				return size;
+			});
+
+			current_block ^= 1;
+			count = 0;
+		}
+	}
+}
@@ -0,0 +1,173 @@
+#include "Sort/Input/Dataset.h"
+#include "Sort/RadixKey.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace Sort
+{
+	namespace Input
+	{
+		namespace
+		{
+			const unsigned char dataset_magic[4] = { 'S', 'K', 'E', 'Y' };
+			const unsigned char dataset_version = 1;
+
+			std::uint64_t readLittleEndian(const unsigned char* bytes, int size)
+			{
+				std::uint64_t value = 0;
+				for (int i = size - 1; i >= 0; i--) value = (value << 8) | bytes[i];
+				return value;
+			}
+
+			// Dense ranks keep every comparison between the keys, for keys wider than an int
+			template<typename Key>
+			void copyRanks(const Key* source, std::size_t count, int* keys)
+			{
+				using Bits = typename RadixKey<Key>::Bits;
+
+				std::vector<std::pair<Bits, std::size_t>> order(count);
+				for (std::size_t i = 0; i < count; i++) order[i] = std::make_pair(RadixKey<Key>::toBits(source[i]), i);
+				std::sort(order.begin(), order.end());
+
+				int rank = 0;
+				for (std::size_t i = 0; i < count; i++)
+				{
+					if (i > 0 && order[i].first != order[i - 1].first) rank++;
+					keys[order[i].second] = rank;
+				}
+			}
+		}
+
+		Dataset::Dataset()
+		{
+			key_type = DatasetType::INT32;
+			key_data = nullptr;
+			number_of_keys = 0;
+		}
+
+		bool Dataset::open(const std::string& path, DatasetType raw_type)
+		{
+			close();
+			error.clear();
+
+			if (!file.open(path))
+			{
+				error = "cannot open " + path;
+				return false;
+			}
+
+			// Samples are mostly read front to back
+			file.adviseSequential();
+
+			if (readHeader()) return true;
+			if (!error.empty())
+			{
+				close();
+				return false;
+			}
+
+			key_type = raw_type;
+			key_data = file.getData();
+			number_of_keys = file.getSize() / getDatasetKeySize(raw_type);
+
+			if (file.getSize() % getDatasetKeySize(raw_type) != 0)
+			{
+				error = path + " is not a whole number of keys";
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		// False with no error when the file simply has no header
+		bool Dataset::readHeader()
+		{
+			const unsigned char* header = file.getData();
+			if (file.getSize() < header_size || std::memcmp(header, dataset_magic, sizeof(dataset_magic)) != 0) return false;
+
+			if (header[4] != dataset_version || header[5] > static_cast<unsigned char>(DatasetType::FLOAT64))
+			{
+				error = "unsupported dataset header";
+				return false;
+			}
+
+			key_type = static_cast<DatasetType>(header[5]);
+			std::uint64_t header_keys = readLittleEndian(header + 8, 8);
+
+			if (header_keys > (file.getSize() - header_size) / getDatasetKeySize(key_type))
+			{
+				error = "dataset header counts more keys than the file holds";
+				return false;
+			}
+
+			key_data = header + header_size;
+			number_of_keys = static_cast<std::size_t>(header_keys);
+			return true;
+		}
+
+		void Dataset::close()
+		{
+			file.close();
+			key_type = DatasetType::INT32;
+			key_data = nullptr;
+			number_of_keys = 0;
+		}
+
+		bool Dataset::isOpen() const { return file.isOpen(); }
+
+		DatasetType Dataset::getKeyType() const { return key_type; }
+
+		std::size_t Dataset::getNumberOfKeys() const { return number_of_keys; }
+
+		const std::string& Dataset::getError() const { return error; }
+
+		void Dataset::copyKeys(std::size_t first, std::size_t count, int* keys) const
+		{
+			if (count == 0) return;
+
+			switch (key_type)
+			{
+			case DatasetType::INT32:
+				std::memcpy(keys, getKeys<std::int32_t>() + first, count * sizeof(int));
+				break;
+
+			case DatasetType::FLOAT32:
+			{
+				const float* source = getKeys<float>() + first;
+				for (std::size_t i = 0; i < count; i++) keys[i] = static_cast<int>(RadixKey<float>::toBits(source[i]) ^ 0x80000000u);
+				break;
+			}
+
+			case DatasetType::INT64:
+				copyRanks(getKeys<std::int64_t>() + first, count, keys);
+				break;
+
+			case DatasetType::FLOAT64:
+				copyRanks(getKeys<double>() + first, count, keys);
+				break;
+			}
+		}
+
+		std::size_t getDatasetKeySize(DatasetType key_type)
+		{
+			return key_type == DatasetType::INT32 || key_type == DatasetType::FLOAT32 ? 4 : 8;
+		}
+
+		bool parseDatasetType(const char* name, DatasetType& key_type)
+		{
+			const char* names[] = { "int32", "int64", "float32", "float64" };
+
+			for (int i = 0; i < 4; i++)
+			{
+				if (std::strcmp(name, names[i]) == 0)
+				{
+					key_type = static_cast<DatasetType>(i);
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+}
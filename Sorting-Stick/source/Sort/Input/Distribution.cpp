@@ -0,0 +1,81 @@
+#include "Sort/Input/Distribution.h"
+#include <cstring>
+
+namespace Sort
+{
+	namespace Input
+	{
+		const char* getDistributionName(Distribution distribution)
+		{
+			switch (distribution)
+			{
+			case Distribution::PERMUTATION:
+				return "permutation";
+			case Distribution::SORTED:
+				return "sorted";
+			case Distribution::REVERSED:
+				return "reversed";
+			case Distribution::NEARLY_SORTED:
+				return "nearly-sorted";
+			case Distribution::FEW_UNIQUE:
+				return "few-unique";
+			case Distribution::ORGAN_PIPE:
+				return "organ-pipe";
+			case Distribution::SAWTOOTH:
+				return "sawtooth";
+			case Distribution::RUNS:
+				return "runs";
+			case Distribution::ZIPF:
+				return "zipf";
+			case Distribution::RANDOM:
+				return "random";
+			case Distribution::DATASET:
+				return "dataset";
+			}
+			return "unknown";
+		}
+
+		const char* getDistributionTitle(Distribution distribution)
+		{
+			switch (distribution)
+			{
+			case Distribution::PERMUTATION:
+				return "Shuffled";
+			case Distribution::SORTED:
+				return "Sorted";
+			case Distribution::REVERSED:
+				return "Reversed";
+			case Distribution::NEARLY_SORTED:
+				return "Nearly Sorted";
+			case Distribution::FEW_UNIQUE:
+				return "Few Unique";
+			case Distribution::ORGAN_PIPE:
+				return "Organ Pipe";
+			case Distribution::SAWTOOTH:
+				return "Sawtooth";
+			case Distribution::RUNS:
+				return "Sorted Runs";
+			case Distribution::ZIPF:
+				return "Zipf";
+			case Distribution::RANDOM:
+				return "Random";
+			case Distribution::DATASET:
+				return "Dataset";
+			}
+			return "Unknown";
+		}
+
+		bool parseDistribution(const char* name, Distribution& distribution)
+		{
+			for (int i = 0; i < number_of_distributions; i++)
+			{
+				if (std::strcmp(name, getDistributionName(static_cast<Distribution>(i))) == 0)
+				{
+					distribution = static_cast<Distribution>(i);
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+}
@@ -0,0 +1,175 @@
+#include "Sort/Input/InputGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace Sort
+{
+	namespace Input
+	{
+		namespace
+		{
+			// std::uniform_int_distribution and std::shuffle differ between standard libraries,
+			// so the draws are done by hand to keep a seed's output the same on every platform
+			std::size_t drawBelow(std::mt19937_64& random_engine, std::size_t bound)
+			{
+				return static_cast<std::size_t>(random_engine() % bound);
+			}
+
+			double drawUnit(std::mt19937_64& random_engine)
+			{
+				return (random_engine() >> 11) * (1.0 / 9007199254740992.0);
+			}
+
+			template<typename Key>
+			void shuffleKeys(std::mt19937_64& random_engine, Key* keys, std::size_t size)
+			{
+				for (std::size_t i = size; i > 1; i--) std::swap(keys[i - 1], keys[drawBelow(random_engine, i)]);
+			}
+		}
+
+		InputGenerator::InputGenerator(std::uint64_t seed)
+		{
+			this->seed = seed;
+
+			nearly_sorted_distance = 8;
+			number_of_unique_keys = 16;
+			number_of_teeth = 8;
+			run_length = 32;
+			zipf_exponent = 1.0;
+		}
+
+		void InputGenerator::setSeed(std::uint64_t seed) { this->seed = seed; }
+
+		std::uint64_t InputGenerator::getSeed() const { return seed; }
+
+		void InputGenerator::setNearlySortedDistance(std::size_t distance) { nearly_sorted_distance = distance; }
+
+		void InputGenerator::setNumberOfUniqueKeys(std::size_t number_of_keys) { number_of_unique_keys = std::max<std::size_t>(1, number_of_keys); }
+
+		void InputGenerator::setNumberOfTeeth(std::size_t number_of_teeth) { this->number_of_teeth = std::max<std::size_t>(1, number_of_teeth); }
+
+		void InputGenerator::setRunLength(std::size_t run_length) { this->run_length = std::max<std::size_t>(1, run_length); }
+
+		void InputGenerator::setZipfExponent(double exponent)
+		{
+			zipf_exponent = exponent;
+			zipf_cumulative.clear();
+		}
+
+		void InputGenerator::generate(Distribution distribution, int* keys, std::size_t size) { generateKeys(distribution, keys, size); }
+
+		void InputGenerator::generate(Distribution distribution, std::int64_t* keys, std::size_t size) { generateKeys(distribution, keys, size); }
+
+		template<typename Key>
+		void InputGenerator::generateKeys(Distribution distribution, Key* keys, std::size_t size)
+		{
+			if (size == 0) return;
+
+			// Mixing the distribution into the seed keeps the inputs of one seed unrelated to each other
+			std::seed_seq seed_sequence{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), static_cast<std::uint32_t>(distribution) };
+			std::mt19937_64 random_engine(seed_sequence);
+
+			switch (distribution)
+			{
+			case Distribution::PERMUTATION:
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(i);
+				shuffleKeys(random_engine, keys, size);
+				break;
+
+			case Distribution::SORTED:
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(i);
+				break;
+
+			case Distribution::REVERSED:
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(size - 1 - i);
+				break;
+
+			case Distribution::NEARLY_SORTED:
+			{
+				// Shuffling inside windows of k + 1 keys moves no key further than k from home
+				std::size_t window = nearly_sorted_distance + 1;
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(i);
+				for (std::size_t begin = 0; begin < size; begin += window) shuffleKeys(random_engine, keys + begin, std::min(window, size - begin));
+				break;
+			}
+
+			case Distribution::FEW_UNIQUE:
+			{
+				std::size_t unique_keys = std::min(number_of_unique_keys, size);
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(drawBelow(random_engine, unique_keys) * (size / unique_keys));
+				break;
+			}
+
+			case Distribution::ORGAN_PIPE:
+				// Even keys climb, odd keys fall: a permutation of 0..N-1 peaking in the middle
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(i < (size + 1) / 2 ? 2 * i : 2 * (size - 1 - i) + 1);
+				break;
+
+			case Distribution::SAWTOOTH:
+			{
+				std::size_t tooth_length = (size + number_of_teeth - 1) / number_of_teeth;
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>((i % tooth_length) * (size / tooth_length));
+				break;
+			}
+
+			case Distribution::RUNS:
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(i);
+				shuffleKeys(random_engine, keys, size);
+				for (std::size_t begin = 0; begin < size; begin += run_length) std::sort(keys + begin, keys + std::min(begin + run_length, size));
+				break;
+
+			case Distribution::ZIPF:
+			{
+				// Rank r is drawn with probability proportional to 1 / r^s; small keys are the common ones
+				std::size_t number_of_ranks = std::min<std::size_t>(size, 1 << 20);
+				buildZipfTable(number_of_ranks);
+
+				std::size_t key_step = size / number_of_ranks;
+				for (std::size_t i = 0; i < size; i++)
+				{
+					double draw = drawUnit(random_engine) * zipf_cumulative.back();
+					std::size_t rank = std::upper_bound(zipf_cumulative.begin(), zipf_cumulative.end(), draw) - zipf_cumulative.begin();
+					keys[i] = static_cast<Key>(std::min(rank, number_of_ranks - 1) * key_step);
+				}
+				break;
+			}
+
+			case Distribution::RANDOM:
+				for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<Key>(random_engine());
+				break;
+
+			case Distribution::DATASET:
+				break; //filled from the Dataset by the caller
+			}
+		}
+
+		void InputGenerator::buildZipfTable(std::size_t number_of_ranks)
+		{
+			if (zipf_cumulative.size() == number_of_ranks) return;
+
+			zipf_cumulative.resize(number_of_ranks);
+
+			double total = 0;
+			for (std::size_t rank = 0; rank < number_of_ranks; rank++)
+			{
+				total += 1.0 / std::pow(static_cast<double>(rank + 1), zipf_exponent);
+				zipf_cumulative[rank] = total;
+			}
+		}
+
+		void InputGenerator::fitToRange(int* keys, std::size_t size, int upper)
+		{
+			if (size == 0) return;
+
+			std::pair<int*, int*> bounds = std::minmax_element(keys, keys + size);
+			long long min = *bounds.first;
+			long long max = *bounds.second;
+
+			if (min >= 0 && max < upper) return;
+
+			long long span = std::max(1LL, max - min);
+			for (std::size_t i = 0; i < size; i++) keys[i] = static_cast<int>((keys[i] - min) * (upper - 1) / span);
+		}
+	}
+}
@@ -0,0 +1,85 @@
+#include "Sort/Metrics/CacheSimulator.h"
+#include <algorithm>
+
+namespace Sort
+{
+	namespace Metrics
+	{
+		CacheSimulator::CacheSimulator(const CacheConfig& cache_config)
+		{
+			configure(cache_config);
+		}
+
+		void CacheSimulator::configure(const CacheConfig& cache_config)
+		{
+			for (int i = 0; i < number_of_cache_levels; i++)
+			{
+				LevelState& level = levels[i];
+				level.config = cache_config.levels[i];
+				level.config.line_size = std::max<std::size_t>(1, level.config.line_size);
+				level.config.associativity = std::max<std::size_t>(1, level.config.associativity);
+
+				std::size_t number_of_lines = std::max(level.config.associativity, level.config.capacity / level.config.line_size);
+				level.number_of_sets = number_of_lines / level.config.associativity;
+			}
+
+			reset();
+		}
+
+		void CacheSimulator::reset()
+		{
+			for (LevelState& level : levels)
+			{
+				level.lines.assign(level.number_of_sets * level.config.associativity, 0);
+				level.last_used.assign(level.lines.size(), 0);
+			}
+
+			clock = 0;
+			statistics = CacheStatistics();
+		}
+
+		void CacheSimulator::access(std::uint64_t address)
+		{
+			clock++;
+			statistics.accesses++;
+
+			for (int i = 0; i < number_of_cache_levels; i++)
+			{
+				if (accessLevel(levels[i], address)) return;
+				statistics.misses[i]++;
+			}
+		}
+
+		bool CacheSimulator::accessLevel(LevelState& level, std::uint64_t address)
+		{
+			std::uint64_t line = address / level.config.line_size;
+			std::size_t first_way = static_cast<std::size_t>(line % level.number_of_sets) * level.config.associativity;
+			std::size_t last_way = first_way + level.config.associativity;
+
+			std::size_t victim = first_way;
+
+			for (std::size_t way = first_way; way < last_way; way++)
+			{
+				if (level.lines[way] == line + 1)
+				{
+					level.last_used[way] = clock;
+					return true;
+				}
+
+				// Empty ways have never been used, so they are picked before any valid line
+				if (level.last_used[way] < level.last_used[victim]) victim = way;
+			}
+
+			level.lines[victim] = line + 1;
+			level.last_used[victim] = clock;
+			return false;
+		}
+
+		const CacheStatistics& CacheSimulator::getStatistics() const { return statistics; }
+
+		CacheConfig CacheSimulator::getDefaultConfig()
+		{
+			return CacheConfig{ { { 32 * 1024, 64, 8 }, { 1024 * 1024, 64, 16 }, { 16 * 1024 * 1024, 64, 16 } } };
+		}
+	}
+}
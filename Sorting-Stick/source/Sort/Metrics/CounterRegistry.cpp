@@ -0,0 +1,109 @@
+#include "Sort/Metrics/CounterRegistry.h"
+#include <utility>
+#include <vector>
+
+namespace Sort
+{
+	namespace Metrics
+	{
+		namespace
+		{
+			std::atomic<std::uint64_t> next_registry_id(1);
+
+			// The shard this thread writes to for each registry it has counted into
+			thread_local std::vector<std::pair<std::uint64_t, void*>> local_shards;
+		}
+
+		CounterRegistry::Shard::Shard()
+		{
+			for (std::atomic<std::uint64_t>& count : counts) count.store(0, std::memory_order_relaxed);
+			next = nullptr;
+		}
+
+		CounterRegistry::CounterRegistry()
+		{
+			shards = nullptr;
+			registry_id = next_registry_id.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		CounterRegistry::~CounterRegistry()
+		{
+			releaseShards();
+		}
+
+		CounterRegistry::Shard* CounterRegistry::getLocalShard()
+		{
+			// Most recently used first, a counting thread almost always hits the first entry
+			if (!local_shards.empty() && local_shards.back().first == registry_id) return static_cast<Shard*>(local_shards.back().second);
+
+			for (std::pair<std::uint64_t, void*>& entry : local_shards)
+			{
+				if (entry.first == registry_id)
+				{
+					std::swap(entry, local_shards.back());
+					return static_cast<Shard*>(local_shards.back().second);
+				}
+			}
+
+			return acquireShard();
+		}
+
+		CounterRegistry::Shard* CounterRegistry::acquireShard()
+		{
+			Shard* shard = new Shard();
+
+			// Lock-free push onto the shard list; shards live until the registry is reset or destroyed
+			Shard* head = shards.load(std::memory_order_relaxed);
+			do shard->next = head;
+			while (!shards.compare_exchange_weak(head, shard, std::memory_order_release, std::memory_order_relaxed));
+
+			// Entries of registries that are gone are never looked up again, drop them before they pile up
+			if (local_shards.size() >= 16) local_shards.clear();
+			local_shards.emplace_back(registry_id, shard);
+
+			return shard;
+		}
+
+		void CounterRegistry::releaseShards()
+		{
+			Shard* shard = shards.exchange(nullptr, std::memory_order_acquire);
+
+			while (shard)
+			{
+				Shard* next = shard->next;
+				delete shard;
+				shard = next;
+			}
+		}
+
+		std::uint64_t CounterRegistry::get(CounterType counter_type) const
+		{
+			std::uint64_t total = 0;
+
+			for (Shard* shard = shards.load(std::memory_order_acquire); shard; shard = shard->next)
+				total += shard->counts[static_cast<int>(counter_type)].load(std::memory_order_relaxed);
+
+			return total;
+		}
+
+		CounterValues CounterRegistry::read() const
+		{
+			CounterValues values;
+
+			for (Shard* shard = shards.load(std::memory_order_acquire); shard; shard = shard->next)
+			{
+				for (int i = 0; i < number_of_counter_types; i++) values.counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+			}
+
+			return values;
+		}
+
+		void CounterRegistry::reset()
+		{
+			releaseShards();
+
+			// A new id makes every thread's cached shard for the old one miss
+			registry_id = next_registry_id.fetch_add(1, std::memory_order_relaxed);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#include "Sort/Metrics/MemoryModel.h"
+
+namespace Sort
+{
+	namespace Metrics
+	{
+		MemoryModel::MemoryModel(const CacheConfig& cache_config) : cache_simulator(cache_config)
+		{
+			element_size = sizeof(int);
+			scratch_base = page_size;
+		}
+
+		void MemoryModel::configure(const CacheConfig& cache_config) { cache_simulator.configure(cache_config); }
+
+		void MemoryModel::reset(std::size_t size, std::size_t element_size)
+		{
+			this->element_size = element_size;
+
+			// One spare page between the arrays keeps them from sharing a line
+			std::uint64_t keys_bytes = static_cast<std::uint64_t>(size) * element_size;
+			scratch_base = (keys_bytes + 2 * page_size - 1) / page_size * page_size;
+
+			cache_simulator.reset();
+		}
+
+		void MemoryModel::access(const SortOperation& operation)
+		{
+			switch (operation.type)
+			{
+			case OperationType::COMPARE:
+				// Only the keys the compare loaded, held keys live in registers
+				if (operation.value >= 1) cache_simulator.access(getKeyAddress(operation.first));
+				if (operation.value >= 2) cache_simulator.access(getKeyAddress(operation.second));
+				break;
+
+			case OperationType::SWAP:
+				cache_simulator.access(getKeyAddress(operation.first));
+				cache_simulator.access(getKeyAddress(operation.second));
+				cache_simulator.access(getKeyAddress(operation.first));
+				cache_simulator.access(getKeyAddress(operation.second));
+				break;
+
+			case OperationType::MOVE:
+				cache_simulator.access(getKeyAddress(operation.first));
+				cache_simulator.access(getKeyAddress(operation.second));
+				break;
+
+			case OperationType::WRITE:
+			case OperationType::READ:
+				cache_simulator.access(getKeyAddress(operation.first));
+				break;
+
+			case OperationType::AUXILIARY_WRITE:
+				cache_simulator.access(getKeyAddress(operation.first));
+				cache_simulator.access(getScratchAddress(operation.second));
+				break;
+
+			case OperationType::HIGHLIGHT:
+			case OperationType::PHASE:
+				break;
+			}
+		}
+
+		const CacheStatistics& MemoryModel::getStatistics() const { return cache_simulator.getStatistics(); }
+	}
+}
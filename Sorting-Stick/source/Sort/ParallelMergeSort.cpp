@@ -0,0 +1,145 @@
+#include "Sort/ParallelMergeSort.h"
+#include "Sort/SortingNetwork.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+namespace Sort
+{
+	ParallelMergeSort::ParallelMergeSort() : base_case_size(std::max(insertion_sort_cutoff, SortingNetwork::getCutoff<int, std::less<int>>()))
+	{
+		number_of_threads = 0;
+	}
+
+	void ParallelMergeSort::setNumberOfThreads(unsigned threads) { number_of_threads = threads; }
+
+	void ParallelMergeSort::sort(int* keys, std::size_t size)
+	{
+		if (size < 2) return;
+
+		unsigned threads = number_of_threads ? number_of_threads : std::max(1u, std::thread::hardware_concurrency());
+
+		scratch.resize(size);
+		sortRange(keys, scratch.data(), size, false, threads);
+	}
+
+	void ParallelMergeSort::sortRange(int* keys, int* buffer, std::size_t size, bool result_in_buffer, unsigned threads)
+	{
+		if (size <= base_case_size)
+		{
+			sortBaseCase(keys, size);
+			if (result_in_buffer) std::copy(keys, keys + size, buffer);
+			return;
+		}
+
+		std::size_t mid = size / 2;
+
+		// Both halves land in the other buffer, so the merge below writes into the one that was asked for
+		if (threads > 1 && size >= parallel_sort_cutoff)
+		{
+			unsigned left_threads = threads / 2;
+
+			std::thread left_thread(&ParallelMergeSort::sortRange, this, keys, buffer, mid, !result_in_buffer, left_threads);
+			sortRange(keys + mid, buffer + mid, size - mid, !result_in_buffer, threads - left_threads);
+			left_thread.join();
+		}
+		else
+		{
+			sortRange(keys, buffer, mid, !result_in_buffer, 1);
+			sortRange(keys + mid, buffer + mid, size - mid, !result_in_buffer, 1);
+		}
+
+		const int* source = result_in_buffer ? keys : buffer;
+		int* target = result_in_buffer ? buffer : keys;
+
+		merge(source, mid, source + mid, size - mid, target, threads);
+	}
+
+	// Equal ints cannot be told apart, so the unstable network does not cost the merge sort its stability
+	void ParallelMergeSort::sortBaseCase(int* keys, std::size_t size)
+	{
+		if (size <= SortingNetwork::getCutoff<int, std::less<int>>()) SortingNetwork::sort(keys, size, std::less<int>());
+		else insertionSort(keys, size);
+	}
+
+	void ParallelMergeSort::insertionSort(int* keys, std::size_t size)
+	{
+		for (std::size_t i = 1; i < size; i++)
+		{
+			int key = keys[i];
+			std::size_t j = i;
+
+			while (j > 0 && key < keys[j - 1])
+			{
+				keys[j] = keys[j - 1];
+				j--;
+			}
+
+			keys[j] = key;
+		}
+	}
+
+	void ParallelMergeSort::merge(const int* left, std::size_t left_size, const int* right, std::size_t right_size, int* output, unsigned threads)
+	{
+		std::size_t total = left_size + right_size;
+
+		if (threads < 2 || total < parallel_merge_cutoff)
+		{
+			mergeSequential(left, left + left_size, right, right + right_size, output);
+			return;
+		}
+
+		// Cut the output into equal slices; co-ranking finds where each slice starts in both inputs
+		std::vector<std::size_t> left_splits(threads + 1);
+		for (unsigned t = 0; t <= threads; t++) left_splits[t] = coRank(total * t / threads, left, left_size, right, right_size);
+
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+
+		for (unsigned t = 0; t < threads; t++)
+		{
+			std::size_t output_begin = total * t / threads;
+			std::size_t output_end = total * (t + 1) / threads;
+
+			const int* left_begin = left + left_splits[t];
+			const int* left_end = left + left_splits[t + 1];
+			const int* right_begin = right + (output_begin - left_splits[t]);
+			const int* right_end = right + (output_end - left_splits[t + 1]);
+
+			if (t + 1 == threads) mergeSequential(left_begin, left_end, right_begin, right_end, output + output_begin);
+			else workers.emplace_back(&ParallelMergeSort::mergeSequential, this, left_begin, left_end, right_begin, right_end, output + output_begin);
+		}
+
+		for (std::thread& worker : workers) worker.join();
+	}
+
+	void ParallelMergeSort::mergeSequential(const int* left, const int* left_end, const int* right, const int* right_end, int* output)
+	{
+		// Take from the left run on ties to stay stable
+		while (left < left_end && right < right_end)
+		{
+			if (*right < *left) *output++ = *right++;
+			else *output++ = *left++;
+		}
+
+		output = std::copy(left, left_end, output);
+		std::copy(right, right_end, output);
+	}
+
+	std::size_t ParallelMergeSort::coRank(std::size_t k, const int* left, std::size_t left_size, const int* right, std::size_t right_size)
+	{
+		// Smallest i such that the first k outputs are left[0, i) and right[0, k - i), with ties going to the left run
+		std::size_t low = k > right_size ? k - right_size : 0;
+		std::size_t high = std::min(k, left_size);
+
+		while (low < high)
+		{
+			std::size_t i = low + (high - low) / 2;
+
+			if (left[i] <= right[k - i - 1]) low = i + 1;
+			else high = i;
+		}
+
+		return low;
+	}
+}
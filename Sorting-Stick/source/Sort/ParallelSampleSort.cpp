@@ -0,0 +1,499 @@
+#include "Sort/ParallelSampleSort.h"
+#include "Sort/InstrumentedArray.h"
+#include "Sort/IntroSort.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+namespace Sort
+{
+	namespace
+	{
+		std::size_t alignToBlock(std::size_t offset, std::size_t block_size)
+		{
+			return (offset + block_size - 1) / block_size * block_size;
+		}
+
+		// Lays sorted splitters [first, last) out as the subtree rooted at node, breadth first
+		void buildTree(int* tree, const int* splitters, std::size_t node, std::size_t first, std::size_t last)
+		{
+			if (first >= last) return;
+
+			std::size_t mid = first + (last - first) / 2;
+			tree[node] = splitters[mid];
+			buildTree(tree, splitters, 2 * node, first, mid);
+			buildTree(tree, splitters, 2 * node + 1, mid + 1, last);
+		}
+	}
+
+	const std::size_t ParallelSampleSort::block_size;
+	const std::size_t ParallelSampleSort::base_case_size;
+	const std::size_t ParallelSampleSort::parallel_sort_cutoff;
+
+	std::size_t ParallelSampleSort::Classifier::getNumberOfBuckets() const
+	{
+		return (std::size_t(1) << log_leaves) * (use_equal_buckets ? 2 : 1);
+	}
+
+	bool ParallelSampleSort::Classifier::isEqualBucket(std::size_t bucket) const { return use_equal_buckets && (bucket & 1); }
+
+	std::size_t ParallelSampleSort::Classifier::classify(int key) const
+	{
+		// Ends on leaf i, where i - leaves is the number of splitters less than the key
+		std::size_t node = 1;
+		for (unsigned level = 0; level < log_leaves; level++) node = 2 * node + (tree[node] < key);
+
+		std::size_t leaf = node - (std::size_t(1) << log_leaves);
+		if (!use_equal_buckets) return leaf;
+
+		// The leaf's splitter is the first not less than the key, so the key is equal to it when not less
+		return 2 * leaf + !(key < splitters[leaf]);
+	}
+
+	ParallelSampleSort::Partition::Partition() : overflow(max_buckets * block_size) { }
+
+	ParallelSampleSort::ThreadContext::ThreadContext() : buffers(max_buckets * block_size), swap_buffers(2 * block_size), partition(new Partition()) { }
+
+	ParallelSampleSort::ParallelSampleSort()
+	{
+		number_of_threads = 0;
+		barrier = nullptr;
+		team_size = 0;
+		next_small_task = 0;
+		big_task_size = 0;
+		shared_depth_limit = 0;
+		is_partitioning_done = false;
+	}
+
+	ParallelSampleSort::~ParallelSampleSort() = default;
+
+	void ParallelSampleSort::setNumberOfThreads(unsigned threads) { number_of_threads = threads; }
+
+	void ParallelSampleSort::sort(int* keys, std::size_t size)
+	{
+		if (size < 2) return;
+
+		unsigned threads = number_of_threads ? number_of_threads : std::max(1u, std::thread::hardware_concurrency());
+		if (size < parallel_sort_cutoff) threads = 1;
+
+		while (contexts.size() < threads) contexts.emplace_back(new ThreadContext());
+		for (std::size_t t = 0; t < contexts.size(); t++) contexts[t]->random_engine.seed(t);
+
+		if (threads == 1)
+		{
+			sortSequential(keys, size, *contexts[0], max_recursion_depth);
+			return;
+		}
+
+		if (!shared_partition) shared_partition.reset(new Partition());
+
+		big_tasks.assign(1, Task{ keys, size, max_recursion_depth });
+		small_tasks.clear();
+		next_small_task = 0;
+		big_task_size = std::max(size / threads, parallel_sort_cutoff);
+		is_partitioning_done = false;
+
+		Global::Barrier team_barrier(threads);
+		barrier = &team_barrier;
+		team_size = threads;
+
+		std::vector<std::thread> workers;
+		workers.reserve(threads - 1);
+		for (unsigned t = 1; t < threads; t++) workers.emplace_back(&ParallelSampleSort::runTeam, this, t);
+
+		runTeam(0);
+		for (std::thread& worker : workers) worker.join();
+
+		barrier = nullptr;
+	}
+
+	void ParallelSampleSort::sortSequential(int* begin, std::size_t size, ThreadContext& context, int depth_limit)
+	{
+		if (size <= base_case_size || depth_limit == 0)
+		{
+			sortBaseCase(begin, size);
+			return;
+		}
+
+		Partition& partition = *context.partition;
+		preparePartition(partition, begin, size, 1);
+		partition.contexts.assign(1, &context);
+
+		buildClassifier(partition, context);
+		classifyStripe(partition, context, 0);
+		computeBuckets(partition);
+		permuteBlocks(partition, context, 0);
+		saveOverflow(partition, 0);
+		fillBucketEdges(partition, 0);
+
+		// The recursion reuses the partition, so keep this level's buckets
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+		std::size_t bucket_begins[max_buckets + 1];
+		std::copy(partition.bucket_begins, partition.bucket_begins + number_of_buckets + 1, bucket_begins);
+		Classifier classifier = partition.classifier;
+
+		for (std::size_t bucket = 0; bucket < number_of_buckets; bucket++)
+		{
+			if (classifier.isEqualBucket(bucket)) continue;
+
+			std::size_t bucket_size = bucket_begins[bucket + 1] - bucket_begins[bucket];
+			if (bucket_size > 1) sortSequential(begin + bucket_begins[bucket], bucket_size, context, depth_limit - 1);
+		}
+	}
+
+	void ParallelSampleSort::sortBaseCase(int* begin, std::size_t size)
+	{
+		using Array = InstrumentedArray<int, NativeAccess>;
+
+		Array array(begin, size, nullptr, NativeAccess());
+		IntroSort<Array>().sort(array);
+	}
+
+	void ParallelSampleSort::runTeam(unsigned thread)
+	{
+		Partition& partition = *shared_partition;
+
+		while (true)
+		{
+			if (thread == 0) prepareBigTask();
+			barrier->wait();
+			if (is_partitioning_done) break;
+
+			classifyStripe(partition, *contexts[thread], thread);
+			barrier->wait();
+
+			if (thread == 0) computeBuckets(partition);
+			barrier->wait();
+
+			moveFullBlocks(partition, thread);
+			barrier->wait();
+
+			permuteBlocks(partition, *contexts[thread], thread);
+			barrier->wait();
+
+			saveOverflow(partition, thread);
+			barrier->wait();
+
+			fillBucketEdges(partition, thread);
+			barrier->wait();
+
+			if (thread == 0) queueBuckets();
+		}
+
+		// Then every thread takes whole buckets off the queue, largest first, and sorts them alone
+		for (std::size_t i = next_small_task++; i < small_tasks.size(); i = next_small_task++)
+			sortSequential(small_tasks[i].begin, small_tasks[i].size, *contexts[thread], small_tasks[i].depth_limit);
+	}
+
+	void ParallelSampleSort::prepareBigTask()
+	{
+		if (big_tasks.empty())
+		{
+			std::sort(small_tasks.begin(), small_tasks.end(), [](const Task& a, const Task& b) { return a.size > b.size; });
+			is_partitioning_done = true;
+			return;
+		}
+
+		Task task = big_tasks.back();
+		big_tasks.pop_back();
+
+		Partition& partition = *shared_partition;
+		preparePartition(partition, task.begin, task.size, team_size);
+		partition.contexts.clear();
+		for (unsigned t = 0; t < team_size; t++) partition.contexts.push_back(contexts[t].get());
+
+		buildClassifier(partition, *contexts[0]);
+		shared_depth_limit = task.depth_limit;
+	}
+
+	void ParallelSampleSort::queueBuckets()
+	{
+		Partition& partition = *shared_partition;
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+
+		for (std::size_t bucket = 0; bucket < number_of_buckets; bucket++)
+		{
+			if (partition.classifier.isEqualBucket(bucket)) continue;
+
+			std::size_t bucket_size = partition.bucket_begins[bucket + 1] - partition.bucket_begins[bucket];
+			if (bucket_size < 2) continue;
+
+			Task task = { partition.begin + partition.bucket_begins[bucket], bucket_size, shared_depth_limit - 1 };
+			if (bucket_size > big_task_size && task.depth_limit > 0) big_tasks.push_back(task);
+			else small_tasks.push_back(task);
+		}
+	}
+
+	void ParallelSampleSort::preparePartition(Partition& partition, int* begin, std::size_t size, unsigned threads)
+	{
+		partition.begin = begin;
+		partition.size = size;
+		partition.number_of_threads = threads;
+
+		// Stripes start on block boundaries so the blocks flushed into them line up across the whole range
+		partition.stripe_begins.resize(threads + 1);
+		for (unsigned t = 0; t < threads; t++) partition.stripe_begins[t] = size * t / threads / block_size * block_size;
+		partition.stripe_begins[threads] = size;
+
+		partition.stripe_full_blocks.assign(threads, 0);
+		partition.blocks_to_move_before.assign(threads + 1, 0);
+		partition.empty_blocks_before.assign(threads + 1, 0);
+	}
+
+	void ParallelSampleSort::buildClassifier(Partition& partition, ThreadContext& context)
+	{
+		int* keys = partition.begin;
+		std::size_t size = partition.size;
+		Classifier& classifier = partition.classifier;
+
+		// Enough leaves that the buckets come out around the base case size
+		classifier.log_leaves = 1;
+		while (classifier.log_leaves < max_log_leaves && (size >> classifier.log_leaves) > base_case_size) classifier.log_leaves++;
+		std::size_t leaves = std::size_t(1) << classifier.log_leaves;
+
+		// Oversampling by 0.2 log N keeps the buckets even without making the sample expensive to sort
+		std::size_t oversampling = std::max<std::size_t>(1, static_cast<std::size_t>(0.2 * std::log2(static_cast<double>(size))));
+		std::size_t sample_size = std::min(size, oversampling * leaves);
+
+		// The sample is moved to the front of the range and sorted there, it is classified like any other key
+		for (std::size_t i = 0; i < sample_size; i++) std::swap(keys[i], keys[i + context.random_engine() % (size - i)]);
+		sortBaseCase(keys, sample_size);
+
+		for (std::size_t leaf = 0; leaf + 1 < leaves; leaf++) classifier.splitters[leaf] = keys[(leaf + 1) * sample_size / leaves];
+		classifier.splitters[leaves - 1] = std::numeric_limits<int>::max();
+
+		// Repeated splitters mean a heavily repeated key; giving it a bucket of its own stops it being partitioned forever
+		classifier.use_equal_buckets = false;
+		for (std::size_t leaf = 0; leaf + 2 < leaves; leaf++)
+			if (classifier.splitters[leaf] == classifier.splitters[leaf + 1]) classifier.use_equal_buckets = true;
+
+		buildTree(classifier.tree, classifier.splitters, 1, 0, leaves - 1);
+	}
+
+	void ParallelSampleSort::classifyStripe(Partition& partition, ThreadContext& context, unsigned thread)
+	{
+		const Classifier& classifier = partition.classifier;
+		std::size_t number_of_buckets = classifier.getNumberOfBuckets();
+
+		int* keys = partition.begin;
+		int* buffers = context.buffers.data();
+		std::size_t* buffer_sizes = context.buffer_sizes;
+
+		std::size_t stripe_begin = partition.stripe_begins[thread];
+		std::size_t stripe_end = partition.stripe_begins[thread + 1];
+		std::size_t write = stripe_begin;
+
+		std::fill(buffer_sizes, buffer_sizes + number_of_buckets, 0);
+		std::fill(context.bucket_sizes, context.bucket_sizes + number_of_buckets, 0);
+
+		// A full buffer goes back into the stripe behind the read position, which is always at least a block ahead
+		auto distribute = [&](int key, std::size_t bucket)
+		{
+			int* buffer = buffers + bucket * block_size;
+			buffer[buffer_sizes[bucket]++] = key;
+
+			if (buffer_sizes[bucket] == block_size)
+			{
+				std::copy(buffer, buffer + block_size, keys + write);
+				write += block_size;
+				buffer_sizes[bucket] = 0;
+				context.bucket_sizes[bucket] += block_size;
+			}
+		};
+
+		// Classifying a batch before distributing it lets the tree descents of different keys overlap
+		const std::size_t batch_size = 8;
+		std::size_t batch_buckets[batch_size];
+		std::size_t i = stripe_begin;
+
+		for (; i + batch_size <= stripe_end; i += batch_size)
+		{
+			for (std::size_t j = 0; j < batch_size; j++) batch_buckets[j] = classifier.classify(keys[i + j]);
+			for (std::size_t j = 0; j < batch_size; j++) distribute(keys[i + j], batch_buckets[j]);
+		}
+
+		for (; i < stripe_end; i++) distribute(keys[i], classifier.classify(keys[i]));
+
+		for (std::size_t bucket = 0; bucket < number_of_buckets; bucket++) context.bucket_sizes[bucket] += buffer_sizes[bucket];
+		partition.stripe_full_blocks[thread] = (write - stripe_begin) / block_size;
+	}
+
+	void ParallelSampleSort::computeBuckets(Partition& partition)
+	{
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+		unsigned threads = partition.number_of_threads;
+
+		partition.bucket_begins[0] = 0;
+		for (std::size_t bucket = 0; bucket < number_of_buckets; bucket++)
+		{
+			std::size_t bucket_size = 0;
+			for (ThreadContext* context : partition.contexts) bucket_size += context->bucket_sizes[bucket];
+			partition.bucket_begins[bucket + 1] = partition.bucket_begins[bucket] + bucket_size;
+		}
+
+		std::size_t full_blocks = 0;
+		for (unsigned t = 0; t < threads; t++) full_blocks += partition.stripe_full_blocks[t];
+		partition.full_end = full_blocks * block_size;
+
+		// Every stripe starts with its full blocks; those past full_end will fill the gaps before it
+		for (unsigned t = 0; t < threads; t++)
+		{
+			std::size_t full_begin = partition.stripe_begins[t];
+			std::size_t full_stop = full_begin + partition.stripe_full_blocks[t] * block_size;
+			std::size_t empty_stop = std::min(partition.stripe_begins[t + 1], partition.full_end);
+
+			std::size_t blocks_to_move = full_stop > partition.full_end ? (full_stop - std::max(full_begin, partition.full_end)) / block_size : 0;
+			std::size_t empty_blocks = empty_stop > full_stop ? (empty_stop - full_stop) / block_size : 0;
+
+			partition.blocks_to_move_before[t + 1] = partition.blocks_to_move_before[t] + blocks_to_move;
+			partition.empty_blocks_before[t + 1] = partition.empty_blocks_before[t] + empty_blocks;
+		}
+
+		// A bucket owns the blocks starting inside it
+		for (std::size_t bucket = 0; bucket < number_of_buckets; bucket++)
+		{
+			std::size_t first_block = alignToBlock(partition.bucket_begins[bucket], block_size);
+			std::size_t last_block = alignToBlock(partition.bucket_begins[bucket + 1], block_size);
+
+			partition.write_pointers[bucket] = first_block;
+			partition.read_pointers[bucket] = std::max(first_block, std::min(last_block, partition.full_end));
+		}
+	}
+
+	void ParallelSampleSort::moveFullBlocks(Partition& partition, unsigned thread)
+	{
+		int* keys = partition.begin;
+
+		std::size_t full_begin = std::max(partition.stripe_begins[thread], partition.full_end);
+		std::size_t full_stop = partition.stripe_begins[thread] + partition.stripe_full_blocks[thread] * block_size;
+		std::size_t rank = partition.blocks_to_move_before[thread];
+		unsigned target_stripe = 0;
+
+		// The n-th full block past full_end goes to the n-th empty block before it; sources and targets never overlap
+		for (std::size_t from = full_begin; from < full_stop; from += block_size, rank++)
+		{
+			while (partition.empty_blocks_before[target_stripe + 1] <= rank) target_stripe++;
+
+			std::size_t to = partition.stripe_begins[target_stripe] + (partition.stripe_full_blocks[target_stripe] + rank - partition.empty_blocks_before[target_stripe]) * block_size;
+			std::copy(keys + from, keys + from + block_size, keys + to);
+		}
+	}
+
+	void ParallelSampleSort::permuteBlocks(Partition& partition, ThreadContext& context, unsigned thread)
+	{
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+		int* block = context.swap_buffers.data();
+		int* displaced_block = block + block_size;
+
+		// Threads start on different buckets so they rarely wait on the same mutex
+		std::size_t first_bucket = thread * number_of_buckets / partition.number_of_threads;
+
+		for (std::size_t i = 0; i < number_of_buckets; i++)
+		{
+			std::size_t bucket = (first_bucket + i) % number_of_buckets;
+
+			// Follow each taken block through the chain of blocks it displaces until one lands in an empty slot
+			while (takeBlock(partition, bucket, block))
+			{
+				while (placeBlock(partition, partition.classifier.classify(block[0]), block, displaced_block)) std::swap(block, displaced_block);
+			}
+		}
+	}
+
+	bool ParallelSampleSort::takeBlock(Partition& partition, std::size_t bucket, int* block)
+	{
+		std::lock_guard<std::mutex> lock(partition.bucket_mutexes[bucket]);
+
+		if (partition.read_pointers[bucket] <= partition.write_pointers[bucket]) return false;
+
+		partition.read_pointers[bucket] -= block_size;
+		const int* source = partition.begin + partition.read_pointers[bucket];
+		std::copy(source, source + block_size, block);
+		return true;
+	}
+
+	bool ParallelSampleSort::placeBlock(Partition& partition, std::size_t bucket, const int* block, int* displaced_block)
+	{
+		std::lock_guard<std::mutex> lock(partition.bucket_mutexes[bucket]);
+
+		int* keys = partition.begin;
+		std::size_t write = partition.write_pointers[bucket];
+		std::size_t read = partition.read_pointers[bucket];
+
+		// Unplaced blocks that already belong here stay where they are
+		while (write < read && partition.classifier.classify(keys[write]) == bucket) write += block_size;
+		partition.write_pointers[bucket] = write + block_size;
+
+		if (write < read)
+		{
+			std::copy(keys + write, keys + write + block_size, displaced_block);
+			std::copy(block, block + block_size, keys + write);
+			return true;
+		}
+
+		// An empty slot; only the last bucket's last block can run past the end of the range
+		std::size_t in_range = std::min(block_size, partition.size - write);
+		std::copy(block, block + in_range, keys + write);
+		if (in_range < block_size) std::copy(block + in_range, block + block_size, partition.overflow.data() + bucket * block_size + (partition.size - partition.bucket_begins[bucket + 1]));
+		return false;
+	}
+
+	void ParallelSampleSort::saveOverflow(Partition& partition, unsigned thread)
+	{
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+
+		// A bucket's last block can spill into the next bucket, whose edges are filled next; move the spilled keys out first
+		for (std::size_t bucket = thread; bucket < number_of_buckets; bucket += partition.number_of_threads)
+		{
+			std::size_t overflow_begin = getOverflowBegin(partition, bucket);
+			std::size_t write = std::min(partition.write_pointers[bucket], partition.size);
+
+			if (write > overflow_begin) std::copy(partition.begin + overflow_begin, partition.begin + write, partition.overflow.data() + bucket * block_size);
+		}
+	}
+
+	std::size_t ParallelSampleSort::getOverflowBegin(const Partition& partition, std::size_t bucket)
+	{
+		// A bucket too small for a block of its own still has its write pointer on the next block boundary
+		return std::max(partition.bucket_begins[bucket + 1], alignToBlock(partition.bucket_begins[bucket], block_size));
+	}
+
+	void ParallelSampleSort::fillBucketEdges(Partition& partition, unsigned thread)
+	{
+		std::size_t number_of_buckets = partition.classifier.getNumberOfBuckets();
+		int* keys = partition.begin;
+
+		for (std::size_t bucket = thread; bucket < number_of_buckets; bucket += partition.number_of_threads)
+		{
+			std::size_t bucket_begin = partition.bucket_begins[bucket];
+			std::size_t bucket_end = partition.bucket_begins[bucket + 1];
+			std::size_t write = partition.write_pointers[bucket];
+
+			// The placed blocks cover [placed_begin, placed_end); the keys still missing go around them
+			std::size_t placed_begin = std::min(alignToBlock(bucket_begin, block_size), bucket_end);
+			std::size_t placed_end = std::max(placed_begin, std::min(write, bucket_end));
+			std::size_t target = bucket_begin;
+
+			auto fill = [&](const int* source, std::size_t count)
+			{
+				while (count > 0)
+				{
+					if (target == placed_begin) target = placed_end;
+
+					std::size_t gap_end = target < placed_begin ? placed_begin : bucket_end;
+					std::size_t length = std::min(count, gap_end - target);
+
+					std::copy(source, source + length, keys + target);
+					target += length;
+					source += length;
+					count -= length;
+				}
+			};
+
+			std::size_t overflow_begin = getOverflowBegin(partition, bucket);
+			if (write > overflow_begin) fill(partition.overflow.data() + bucket * block_size, write - overflow_begin);
+			for (ThreadContext* context : partition.contexts) fill(context->buffers.data() + bucket * block_size, context->buffer_sizes[bucket]);
+		}
+	}
+}
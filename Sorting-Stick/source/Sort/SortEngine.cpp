@@ -0,0 +1,133 @@
+#include "Sort/SortEngine.h"
+#include "Sort/BasicSortEngine.h"
+#include "Sort/External/ExternalMergeSort.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+namespace Sort
+{
+	namespace
+	{
+		// Gives the external merge sort's operations to the counters, the sink it takes being the only way in
+		class CountingSink : public Interface::IOperationSink
+		{
+		private:
+			CountingAccess counting_access;
+
+		public:
+			explicit CountingSink(CountingAccess counting_access) : counting_access(counting_access) { }
+
+			void onOperation(const SortOperation& operation) override { counting_access.emit(operation.type, operation.first, operation.second, operation.value); }
+			bool isCancelled() override { return false; }
+		};
+	}
+
+	SortEngine::SortEngine()
+	{
+		operation_sink = nullptr;
+		operation_counters = nullptr;
+		memory_model = nullptr;
+		key_sort_engine = new BasicSortEngine<int>();
+		number_of_threads = 0;
+		external_merge_sort = nullptr;
+		external_memory_budget = std::size_t(64) << 20;
+		external_file_path = "external_sort";
+	}
+
+	SortEngine::~SortEngine()
+	{
+		delete key_sort_engine;
+		delete external_merge_sort;
+	}
+
+	void SortEngine::setOperationSink(Interface::IOperationSink* sink)
+	{
+		operation_sink = sink;
+		key_sort_engine->setOperationSink(sink);
+	}
+
+	void SortEngine::setOperationCounters(Metrics::OperationCounters<>* counters, Metrics::MemoryModel* memory_model)
+	{
+		operation_counters = counters;
+		this->memory_model = memory_model;
+		key_sort_engine->setOperationCounters(counters, memory_model);
+	}
+
+	void SortEngine::setNumberOfThreads(unsigned threads)
+	{
+		number_of_threads = threads;
+		parallel_merge_sort.setNumberOfThreads(threads);
+		parallel_sample_sort.setNumberOfThreads(threads);
+	}
+
+	void SortEngine::setHeapArity(unsigned arity) { key_sort_engine->setHeapArity(arity); }
+
+	unsigned SortEngine::getHeapArity() const { return key_sort_engine->getHeapArity(); }
+
+	void SortEngine::setExternalSortOptions(std::size_t memory_budget, const std::string& file_path)
+	{
+		external_memory_budget = memory_budget;
+		external_file_path = file_path;
+	}
+
+	void SortEngine::sort(SortType sort_type, int* keys, std::size_t size)
+	{
+		if (size < 2) return;
+
+		if (sort_type == SortType::EXTERNAL_MERGE_SORT)
+		{
+			sortExternal(keys, size);
+		}
+		else if (operation_sink || operation_counters)
+		{
+			key_sort_engine->sort(sort_type, keys, size);
+		}
+		else if (sort_type == SortType::MERGE_SORT)
+		{
+			// Nothing to report to, so use every core; the split merges cannot be replayed as one stream
+			parallel_merge_sort.sort(keys, size);
+		}
+		else if (sort_type == SortType::QUICK_SORT)
+		{
+			// Likewise the quick sort becomes a samplesort: IntroSort's partition is one thread's pass over the range
+			parallel_sample_sort.sort(keys, size);
+		}
+		else
+		{
+			key_sort_engine->sort(sort_type, keys, size);
+		}
+	}
+
+	// The array takes a round trip through files, so a failed write or read leaves it as it was
+	void SortEngine::sortExternal(int* keys, std::size_t size)
+	{
+		if (!external_merge_sort) external_merge_sort = new External::ExternalMergeSort();
+
+		std::string input_path = external_file_path + ".input";
+		std::string output_path = external_file_path + ".output";
+
+		std::ofstream input(input_path, std::ios::binary | std::ios::trunc);
+		input.write(reinterpret_cast<const char*>(keys), size * sizeof(int));
+		input.close();
+
+		CountingSink counting_sink(CountingAccess(operation_counters, memory_model));
+
+		external_merge_sort->setMemoryBudget(external_memory_budget);
+		external_merge_sort->setNumberOfThreads(number_of_threads);
+		external_merge_sort->setOperationSink(operation_sink ? operation_sink : operation_counters ? &counting_sink : nullptr);
+
+		if (!input.fail() && external_merge_sort->sort(input_path, output_path))
+		{
+			std::ifstream output(output_path, std::ios::binary);
+			std::vector<int> sorted_keys(size);
+			output.read(reinterpret_cast<char*>(sorted_keys.data()), size * sizeof(int));
+
+			if (static_cast<std::size_t>(output.gcount()) == size * sizeof(int)) std::copy(sorted_keys.begin(), sorted_keys.end(), keys);
+		}
+
+		external_merge_sort->setOperationSink(nullptr);
+		std::remove(input_path.c_str());
+		std::remove(output_path.c_str());
+	}
+}
@@ -0,0 +1,378 @@
+#include "Sort/SortingNetwork.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(SORT_NETWORK_AVX512) || defined(SORT_NETWORK_AVX2) || defined(SORT_NETWORK_SSE4_1)
+#include <immintrin.h>
+#define SORT_NETWORK_VECTORIZED
+#endif
+
+namespace Sort
+{
+#ifdef SORT_NETWORK_VECTORIZED
+	namespace
+	{
+		// In layer (K, J) of a bitonic sort, lane i meets lane i ^ J and keeps the larger key when it is
+		// the upper lane of an ascending block of K lanes or the lower lane of a descending one
+		constexpr bool takesLarger(unsigned lane, unsigned k, unsigned j) { return ((lane & j) != 0) != ((lane & k) != 0); }
+
+		// Blend immediate with bits_per_lane bits per lane, set where the lane takes the larger key
+		constexpr unsigned getBlendMask(unsigned lanes, unsigned bits_per_lane, unsigned k, unsigned j)
+		{
+			unsigned mask = 0;
+			for (unsigned lane = 0; lane < lanes; lane++)
+				if (takesLarger(lane, k, j)) mask |= ((1u << bits_per_lane) - 1) << (lane * bits_per_lane);
+			return mask;
+		}
+
+		// Shuffle immediate of four 2-bit selectors where lane i reads lane i ^ j
+		constexpr int getShuffleMask(unsigned j) { return static_cast<int>((0 ^ j) | ((1 ^ j) << 2) | ((2 ^ j) << 4) | ((3 ^ j) << 6)); }
+
+#if defined(SORT_NETWORK_AVX512)
+		struct Int32Vector
+		{
+			using Key = std::int32_t;
+			using Register = __m512i;
+			static const unsigned lanes = 16;
+
+			static Register load(const Key* keys) { return _mm512_loadu_si512(keys); }
+			static void store(Key* keys, Register v) { _mm512_storeu_si512(keys, v); }
+			static Register min(Register a, Register b) { return _mm512_min_epi32(a, b); }
+			static Register max(Register a, Register b) { return _mm512_max_epi32(a, b); }
+			static Register reverse(Register v) { return _mm512_permutexvar_epi32(_mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), v); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr __mmask16 mask = static_cast<__mmask16>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm512_permutexvar_epi32(_mm512_set_epi32(15 ^ J, 14 ^ J, 13 ^ J, 12 ^ J, 11 ^ J, 10 ^ J, 9 ^ J, 8 ^ J, 7 ^ J, 6 ^ J, 5 ^ J, 4 ^ J, 3 ^ J, 2 ^ J, 1 ^ J, 0 ^ J), v);
+				return _mm512_mask_blend_epi32(mask, min(v, partner), max(v, partner));
+			}
+		};
+
+		struct FloatVector
+		{
+			using Key = float;
+			using Register = __m512;
+			static const unsigned lanes = 16;
+
+			static Register load(const Key* keys) { return _mm512_loadu_ps(keys); }
+			static void store(Key* keys, Register v) { _mm512_storeu_ps(keys, v); }
+			static Register min(Register a, Register b) { return _mm512_min_ps(a, b); }
+			static Register max(Register a, Register b) { return _mm512_max_ps(a, b); }
+			static Register reverse(Register v) { return _mm512_permutexvar_ps(_mm512_set_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), v); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr __mmask16 mask = static_cast<__mmask16>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm512_permutexvar_ps(_mm512_set_epi32(15 ^ J, 14 ^ J, 13 ^ J, 12 ^ J, 11 ^ J, 10 ^ J, 9 ^ J, 8 ^ J, 7 ^ J, 6 ^ J, 5 ^ J, 4 ^ J, 3 ^ J, 2 ^ J, 1 ^ J, 0 ^ J), v);
+				return _mm512_mask_blend_ps(mask, min(v, partner), max(v, partner));
+			}
+		};
+
+		struct Int64Vector
+		{
+			using Key = std::int64_t;
+			using Register = __m512i;
+			static const unsigned lanes = 8;
+
+			static Register load(const Key* keys) { return _mm512_loadu_si512(keys); }
+			static void store(Key* keys, Register v) { _mm512_storeu_si512(keys, v); }
+			static Register min(Register a, Register b) { return _mm512_min_epi64(a, b); }
+			static Register max(Register a, Register b) { return _mm512_max_epi64(a, b); }
+			static Register reverse(Register v) { return _mm512_permutexvar_epi64(_mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7), v); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr __mmask8 mask = static_cast<__mmask8>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm512_permutexvar_epi64(_mm512_set_epi64(7 ^ J, 6 ^ J, 5 ^ J, 4 ^ J, 3 ^ J, 2 ^ J, 1 ^ J, 0 ^ J), v);
+				return _mm512_mask_blend_epi64(mask, min(v, partner), max(v, partner));
+			}
+		};
+#elif defined(SORT_NETWORK_AVX2)
+		struct Int32Vector
+		{
+			using Key = std::int32_t;
+			using Register = __m256i;
+			static const unsigned lanes = 8;
+
+			static Register load(const Key* keys) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)); }
+			static void store(Key* keys, Register v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys), v); }
+			static Register min(Register a, Register b) { return _mm256_min_epi32(a, b); }
+			static Register max(Register a, Register b) { return _mm256_max_epi32(a, b); }
+			static Register reverse(Register v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr int mask = static_cast<int>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+				return _mm256_blend_epi32(min(v, partner), max(v, partner), mask);
+			}
+		};
+
+		struct FloatVector
+		{
+			using Key = float;
+			using Register = __m256;
+			static const unsigned lanes = 8;
+
+			static Register load(const Key* keys) { return _mm256_loadu_ps(keys); }
+			static void store(Key* keys, Register v) { _mm256_storeu_ps(keys, v); }
+			static Register min(Register a, Register b) { return _mm256_min_ps(a, b); }
+			static Register max(Register a, Register b) { return _mm256_max_ps(a, b); }
+			static Register reverse(Register v) { return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr int mask = static_cast<int>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J));
+				return _mm256_blend_ps(min(v, partner), max(v, partner), mask);
+			}
+		};
+
+		// AVX2 has no 64-bit min / max; one signed compare drives both selects
+		struct Int64Vector
+		{
+			using Key = std::int64_t;
+			using Register = __m256i;
+			static const unsigned lanes = 4;
+
+			static Register load(const Key* keys) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys)); }
+			static void store(Key* keys, Register v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(keys), v); }
+			static Register min(Register a, Register b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+			static Register max(Register a, Register b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+			static Register reverse(Register v) { return _mm256_permute4x64_epi64(v, 0x1B); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr int mask = static_cast<int>(getBlendMask(lanes, 2, K, J));
+				Register partner = _mm256_permute4x64_epi64(v, getShuffleMask(J));
+				Register is_greater = _mm256_cmpgt_epi64(v, partner);
+				Register low = _mm256_blendv_epi8(v, partner, is_greater);
+				Register high = _mm256_blendv_epi8(partner, v, is_greater);
+				return _mm256_blend_epi32(low, high, mask);
+			}
+		};
+#else
+		struct Int32Vector
+		{
+			using Key = std::int32_t;
+			using Register = __m128i;
+			static const unsigned lanes = 4;
+
+			static Register load(const Key* keys) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)); }
+			static void store(Key* keys, Register v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(keys), v); }
+			static Register min(Register a, Register b) { return _mm_min_epi32(a, b); }
+			static Register max(Register a, Register b) { return _mm_max_epi32(a, b); }
+			static Register reverse(Register v) { return _mm_shuffle_epi32(v, 0x1B); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr int mask = static_cast<int>(getBlendMask(lanes, 2, K, J));
+				Register partner = _mm_shuffle_epi32(v, getShuffleMask(J));
+				return _mm_blend_epi16(min(v, partner), max(v, partner), mask);
+			}
+		};
+
+		struct FloatVector
+		{
+			using Key = float;
+			using Register = __m128;
+			static const unsigned lanes = 4;
+
+			static Register load(const Key* keys) { return _mm_loadu_ps(keys); }
+			static void store(Key* keys, Register v) { _mm_storeu_ps(keys, v); }
+			static Register min(Register a, Register b) { return _mm_min_ps(a, b); }
+			static Register max(Register a, Register b) { return _mm_max_ps(a, b); }
+			static Register reverse(Register v) { return _mm_shuffle_ps(v, v, 0x1B); }
+
+			template<unsigned K, unsigned J>
+			static Register exchange(Register v)
+			{
+				constexpr int mask = static_cast<int>(getBlendMask(lanes, 1, K, J));
+				Register partner = _mm_shuffle_ps(v, v, getShuffleMask(J));
+				return _mm_blend_ps(min(v, partner), max(v, partner), mask);
+			}
+		};
+#endif
+
+		// Applies the bitonic layers (K, J), (K, J / 2) ... (K, 1), then (2K, K) ... until K passes the lanes
+		template<typename Vector, unsigned K, unsigned J, bool IsDone = (K > Vector::lanes)>
+		struct BitonicLayers
+		{
+			static typename Vector::Register apply(typename Vector::Register v)
+			{
+				return BitonicLayers<Vector, (J > 1 ? K : 2 * K), (J > 1 ? J / 2 : K)>::apply(Vector::template exchange<K, J>(v));
+			}
+		};
+
+		template<typename Vector, unsigned K, unsigned J>
+		struct BitonicLayers<Vector, K, J, true>
+		{
+			static typename Vector::Register apply(typename Vector::Register v) { return v; }
+		};
+
+		// Sorts the lanes of one register
+		template<typename Vector>
+		typename Vector::Register sortLanes(typename Vector::Register v) { return BitonicLayers<Vector, 2, 1>::apply(v); }
+
+		// Sorts the lanes of a register holding a bitonic sequence
+		template<typename Vector>
+		typename Vector::Register mergeLanes(typename Vector::Register v) { return BitonicLayers<Vector, Vector::lanes, Vector::lanes / 2>::apply(v); }
+
+		// Leaves the smaller key of every lane pair in low and the larger in high. The float min and max
+		// instructions both return their second operand on a tie or a NaN, so max takes the operands the other
+		// way round and each key lands on one side: -0.0 and 0.0 keep their signs and NaNs are not lost.
+		// exchange gets this for free, a lane and its partner passing each other's keys in opposite order.
+		template<typename Vector>
+		void compareExchange(typename Vector::Register& low, typename Vector::Register& high)
+		{
+			typename Vector::Register smaller = Vector::min(low, high);
+			high = Vector::max(high, low);
+			low = smaller;
+		}
+
+		// Merges the sorted runs registers[0, run) and registers[run, 2 run) into one sorted run
+		template<typename Vector>
+		void mergeRuns(typename Vector::Register* registers, std::size_t run)
+		{
+			using Register = typename Vector::Register;
+
+			// The first run followed by the second one reversed is bitonic. Comparing it against its own second half
+			// splits it into two bitonic halves with every key of the lower one not above any key of the upper one.
+			for (std::size_t i = 0; i < (run + 1) / 2; i++)
+			{
+				std::size_t j = run - 1 - i;
+
+				Register first_i = registers[i];
+				Register first_j = registers[j];
+				Register second_i = Vector::reverse(registers[run + j]);
+				Register second_j = Vector::reverse(registers[run + i]);
+
+				compareExchange<Vector>(first_i, second_i);
+				compareExchange<Vector>(first_j, second_j);
+
+				registers[i] = first_i;
+				registers[run + i] = second_i;
+				registers[j] = first_j;
+				registers[run + j] = second_j;
+			}
+
+			// Then each half is merged, across registers first and within them last
+			for (std::size_t half = 0; half < 2 * run; half += run)
+			{
+				for (std::size_t distance = run / 2; distance > 0; distance /= 2)
+				{
+					for (std::size_t i = half; i < half + run; i++)
+					{
+						if (i & distance) continue;
+						compareExchange<Vector>(registers[i], registers[i + distance]);
+					}
+				}
+			}
+
+			for (std::size_t i = 0; i < 2 * run; i++) registers[i] = mergeLanes<Vector>(registers[i]);
+		}
+
+		template<typename Vector, std::size_t Count>
+		void sortRegisters(typename Vector::Key* keys, std::size_t size)
+		{
+			using Key = typename Vector::Key;
+			using Register = typename Vector::Register;
+			const std::size_t capacity = Count * Vector::lanes;
+
+			// A short range is padded with the largest key, which sorts to the end and is cut off on the way out
+			Key largest = std::numeric_limits<Key>::has_infinity ? std::numeric_limits<Key>::infinity() : std::numeric_limits<Key>::max();
+			Key padded[capacity];
+			Key* block = keys;
+			if (size < capacity)
+			{
+				std::copy(keys, keys + size, padded);
+				std::fill(padded + size, padded + capacity, largest);
+				block = padded;
+			}
+
+			Register registers[Count];
+			for (std::size_t i = 0; i < Count; i++) registers[i] = sortLanes<Vector>(Vector::load(block + i * Vector::lanes));
+
+			for (std::size_t run = 1; run < Count; run *= 2)
+				for (std::size_t begin = 0; begin < Count; begin += 2 * run) mergeRuns<Vector>(registers + begin, run);
+
+			for (std::size_t i = 0; i < Count; i++) Vector::store(block + i * Vector::lanes, registers[i]);
+			if (block != padded) return;
+
+			if (!std::numeric_limits<Key>::has_quiet_NaN)
+			{
+				std::copy(padded, padded + size, keys);
+				return;
+			}
+
+			// NaNs compare with nothing and may have sorted past the padding, so the padding is taken out by count
+			std::size_t padding = capacity - size;
+			std::size_t out = size;
+			for (std::size_t i = capacity; i-- > 0;)
+			{
+				if (padding > 0 && padded[i] == largest) padding--;
+				else keys[--out] = padded[i];
+			}
+		}
+
+		template<typename Vector>
+		void sortVectorized(typename Vector::Key* keys, std::size_t size)
+		{
+			std::size_t number_of_registers = (size + Vector::lanes - 1) / Vector::lanes;
+
+			if (number_of_registers <= 1) sortRegisters<Vector, 1>(keys, size);
+			else if (number_of_registers <= 2) sortRegisters<Vector, 2>(keys, size);
+			else if (number_of_registers <= 4) sortRegisters<Vector, 4>(keys, size);
+			else if (number_of_registers <= 8) sortRegisters<Vector, 8>(keys, size);
+			else sortRegisters<Vector, 16>(keys, size);
+		}
+	}
+#endif
+
+	const std::size_t SortingNetwork::max_size;
+	const std::size_t SortingNetwork::scalar_cutoff;
+
+	void SortingNetwork::sort(std::int32_t* keys, std::size_t size, const std::less<std::int32_t>& compare)
+	{
+		if (size < 2) return;
+
+#ifdef SORT_NETWORK_VECTORIZED
+		(void)compare;
+		sortVectorized<Int32Vector>(keys, size);
+#else
+		sort<std::int32_t, std::less<std::int32_t>>(keys, size, compare);
+#endif
+	}
+
+	void SortingNetwork::sort(float* keys, std::size_t size, const std::less<float>& compare)
+	{
+		if (size < 2) return;
+
+#ifdef SORT_NETWORK_VECTORIZED
+		(void)compare;
+		sortVectorized<FloatVector>(keys, size);
+#else
+		sort<float, std::less<float>>(keys, size, compare);
+#endif
+	}
+
+	void SortingNetwork::sort(std::int64_t* keys, std::size_t size, const std::less<std::int64_t>& compare)
+	{
+		if (size < 2) return;
+
+#if defined(SORT_NETWORK_AVX512) || defined(SORT_NETWORK_AVX2)
+		(void)compare;
+		sortVectorized<Int64Vector>(keys, size);
+#else
+		sort<std::int64_t, std::less<std::int64_t>>(keys, size, compare);
+#endif
+	}
+}
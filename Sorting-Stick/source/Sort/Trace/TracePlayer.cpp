@@ -0,0 +1,170 @@
+#include "Sort/Trace/TracePlayer.h"
+#include "Sort/Trace/TraceFormat.h"
+#include <cstring>
+
+namespace Sort
+{
+	namespace Trace
+	{
+		TracePlayer::TracePlayer()
+		{
+			operations_begin = nullptr;
+			cursor = nullptr;
+			end = nullptr;
+			last_index = 0;
+		}
+
+		TracePlayer::~TracePlayer() { close(); }
+
+		bool TracePlayer::open(const std::string& path)
+		{
+			close();
+
+			if (!trace_file.open(path)) return false;
+			trace_file.adviseSequential();
+
+			if (!readHeader())
+			{
+				close();
+				return false;
+			}
+
+			return true;
+		}
+
+		void TracePlayer::close()
+		{
+			trace_file.close();
+			initial_keys.clear();
+
+			operations_begin = nullptr;
+			cursor = nullptr;
+			end = nullptr;
+			last_index = 0;
+		}
+
+		void TracePlayer::rewind()
+		{
+			cursor = operations_begin;
+			last_index = 0;
+		}
+
+		bool TracePlayer::readHeader()
+		{
+			cursor = trace_file.getData();
+			end = cursor + trace_file.getSize();
+
+			if (trace_file.getSize() < sizeof(trace_magic) + 1) return false;
+			if (std::memcmp(cursor, trace_magic, sizeof(trace_magic)) != 0) return false;
+			cursor += sizeof(trace_magic);
+
+			if (*cursor++ != trace_version) return false;
+
+			std::uint64_t size;
+			if (!readVarint(cursor, end, size)) return false;
+
+			// Every key takes at least a byte, so a larger count is a corrupt header and not worth allocating for
+			if (size > static_cast<std::uint64_t>(end - cursor)) return false;
+
+			initial_keys.resize(static_cast<std::size_t>(size));
+			for (std::size_t i = 0; i < initial_keys.size(); i++)
+			{
+				std::uint64_t key;
+				if (!readVarint(cursor, end, key)) return false;
+				initial_keys[i] = static_cast<int>(decodeZigZag(key));
+			}
+
+			operations_begin = cursor;
+			last_index = 0;
+			return true;
+		}
+
+		std::size_t TracePlayer::readIndex(std::uint64_t encoded_delta)
+		{
+			last_index = static_cast<std::size_t>(static_cast<std::int64_t>(last_index) + decodeZigZag(encoded_delta));
+			return last_index;
+		}
+
+		bool TracePlayer::next(SortOperation& operation)
+		{
+			if (cursor >= end) return false;
+
+			// Decode against a local cursor so a record cut short by a cancelled recording is dropped whole
+			const unsigned char* record = cursor;
+			unsigned char tag = *record++;
+
+			operation.type = static_cast<OperationType>(tag & operation_type_mask);
+			operation.first = 0;
+			operation.second = 0;
+			operation.value = 0;
+
+			std::uint64_t first = 0;
+			std::uint64_t second = 0;
+			bool valid = readVarint(record, end, first);
+
+			switch (operation.type)
+			{
+			case OperationType::COMPARE:
+			case OperationType::SWAP:
+			case OperationType::MOVE:
+			case OperationType::AUXILIARY_WRITE:
+				valid = valid && readVarint(record, end, second);
+				operation.first = readIndex(first);
+				operation.second = static_cast<std::size_t>(static_cast<std::int64_t>(operation.first) + decodeZigZag(second));
+				valid = valid && operation.second < initial_keys.size();
+				if (operation.type == OperationType::COMPARE) operation.value = tag >> operation_type_bits;
+				break;
+
+			case OperationType::WRITE:
+				valid = valid && readVarint(record, end, second);
+				operation.first = readIndex(first);
+				operation.value = static_cast<int>(decodeZigZag(second));
+				break;
+
+			case OperationType::READ:
+				operation.first = readIndex(first);
+				break;
+
+			case OperationType::HIGHLIGHT:
+				operation.first = readIndex(first);
+				operation.value = tag >> operation_type_bits;
+				break;
+
+			case OperationType::PHASE:
+				valid = valid && readVarint(record, end, second);
+				valid = valid && first <= initial_keys.size() && second <= initial_keys.size() - first;
+				operation.first = static_cast<std::size_t>(first);
+				operation.second = static_cast<std::size_t>(first + second);
+				operation.value = tag >> operation_type_bits;
+				break;
+
+			default:
+				valid = false;
+				break;
+			}
+
+			if (!valid || operation.first >= initial_keys.size() + (operation.type == OperationType::PHASE ? 1 : 0))
+			{
+				cursor = end;
+				return false;
+			}
+
+			cursor = record;
+			return true;
+		}
+
+		bool TracePlayer::isOpen() const { return trace_file.isOpen(); }
+
+		bool TracePlayer::isFinished() const { return cursor >= end; }
+
+		float TracePlayer::getProgress() const
+		{
+			if (end == operations_begin) return 1.f;
+			return static_cast<float>(cursor - operations_begin) / static_cast<float>(end - operations_begin);
+		}
+
+		std::size_t TracePlayer::getNumberOfElements() const { return initial_keys.size(); }
+
+		const std::vector<int>& TracePlayer::getInitialKeys() const { return initial_keys; }
+	}
+}
@@ -0,0 +1,115 @@
+#include "Sort/Trace/TraceRecorder.h"
+#include "Sort/Trace/TraceFormat.h"
+
+namespace Sort
+{
+	namespace Trace
+	{
+		TraceRecorder::TraceRecorder()
+		{
+			last_index = 0;
+			number_of_operations = 0;
+		}
+
+		TraceRecorder::~TraceRecorder() { close(); }
+
+		bool TraceRecorder::open(const std::string& path, const int* keys, std::size_t size, Global::StopToken stop_token)
+		{
+			close();
+
+			trace_stream.open(path, std::ios::binary | std::ios::trunc);
+			if (!trace_stream.is_open()) return false;
+
+			buffer.clear();
+			buffer.reserve(buffer_capacity);
+			last_index = 0;
+			number_of_operations = 0;
+			this->stop_token = stop_token;
+
+			buffer.insert(buffer.end(), trace_magic, trace_magic + sizeof(trace_magic));
+			buffer.push_back(trace_version);
+			writeVarint(buffer, size);
+
+			for (std::size_t i = 0; i < size; i++)
+			{
+				writeVarint(buffer, encodeZigZag(keys[i]));
+				if (buffer.size() >= buffer_capacity) flush();
+			}
+
+			return true;
+		}
+
+		void TraceRecorder::close()
+		{
+			if (!trace_stream.is_open()) return;
+
+			flush();
+			trace_stream.close();
+		}
+
+		bool TraceRecorder::isCancelled() { return stop_token.isStopRequested(); }
+
+		void TraceRecorder::onOperation(const SortOperation& operation)
+		{
+			unsigned char tag = static_cast<unsigned char>(operation.type);
+
+			switch (operation.type)
+			{
+			case OperationType::COMPARE:
+				buffer.push_back(static_cast<unsigned char>(tag | (operation.value << operation_type_bits)));
+				writeIndex(operation.first);
+				writeVarint(buffer, encodeZigZag(static_cast<std::int64_t>(operation.second) - static_cast<std::int64_t>(operation.first)));
+				break;
+
+			case OperationType::SWAP:
+			case OperationType::MOVE:
+			case OperationType::AUXILIARY_WRITE:
+				buffer.push_back(tag);
+				writeIndex(operation.first);
+				writeVarint(buffer, encodeZigZag(static_cast<std::int64_t>(operation.second) - static_cast<std::int64_t>(operation.first)));
+				break;
+
+			case OperationType::WRITE:
+				buffer.push_back(tag);
+				writeIndex(operation.first);
+				writeVarint(buffer, encodeZigZag(operation.value));
+				break;
+
+			case OperationType::READ:
+				buffer.push_back(tag);
+				writeIndex(operation.first);
+				break;
+
+			case OperationType::HIGHLIGHT:
+				buffer.push_back(static_cast<unsigned char>(tag | (operation.value << operation_type_bits)));
+				writeIndex(operation.first);
+				break;
+
+			case OperationType::PHASE:
+				buffer.push_back(static_cast<unsigned char>(tag | (operation.value << operation_type_bits)));
+				writeVarint(buffer, operation.first);
+				writeVarint(buffer, operation.second - operation.first);
+				break;
+			}
+
+			number_of_operations++;
+			if (buffer.size() >= buffer_capacity) flush();
+		}
+
+		std::uint64_t TraceRecorder::getNumberOfOperations() const { return number_of_operations; }
+
+		void TraceRecorder::writeIndex(std::size_t index)
+		{
+			writeVarint(buffer, encodeZigZag(static_cast<std::int64_t>(index) - static_cast<std::int64_t>(last_index)));
+			last_index = index;
+		}
+
+		void TraceRecorder::flush()
+		{
+			if (buffer.empty()) return;
+
+			trace_stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+			buffer.clear();
+		}
+	}
+}
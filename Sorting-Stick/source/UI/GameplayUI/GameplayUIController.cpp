@@ -3,6 +3,8 @@
 #include "Global/ServiceLocator.h"
 #include "Gameplay/GameplayService.h"
 #include "Sound/SoundService.h"
+#include "Event/EventService.h"
+#include "Graphics/GraphicService.h"
 #include "Main/GameService.h"
 #include "Gameplay/Collection/StickCollectionModel.h"
 
@@ -46,8 +48,11 @@ namespace UI
             array_access_text = new TextView();
 
             num_sticks_text = new TextView();
-            delay_text = new TextView();
+            speed_text = new TextView();
             time_complexity_text = new TextView();
+
+            cache_misses_text = new TextView();
+            miss_rate_text = new TextView();
         }
 
         void GameplayUIController::initializeButton()
@@ -69,10 +74,13 @@ namespace UI
             num_sticks_text->initialize("Number of Sticks  :  0", sf::Vector2f(num_sticks_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
 
 
-            delay_text->initialize("Delay  :  0 ms", sf::Vector2f(delay_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
+            speed_text->initialize("Speed  :  25 / s", sf::Vector2f(speed_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
 
 
             time_complexity_text->initialize("Time Complexity  :  O(n)", sf::Vector2f(time_complexity_text_x_position, text_y_pos2), FontType::BUBBLE_BOBBLE, font_size);
+
+            cache_misses_text->initialize("Cache Misses  :  0 / 0 / 0", sf::Vector2f(cache_misses_text_x_position, text_y_pos3), FontType::BUBBLE_BOBBLE, font_size);
+            miss_rate_text->initialize("L1 Miss Rate  :  0 %", sf::Vector2f(miss_rate_text_x_position, text_y_pos3), FontType::BUBBLE_BOBBLE, font_size);
         }
 
         void GameplayUIController::update()
@@ -83,8 +91,9 @@ namespace UI
             updateArrayAccessText();
 
             updateNumberOfSticksText();
-            updateDelayText();
+            updateSpeedText();
             updateTimeComplexityText();
+            updateCacheTexts();
         }
 
         void GameplayUIController::render()
@@ -95,8 +104,14 @@ namespace UI
             array_access_text->render();
 
             num_sticks_text->render();
-            delay_text->render();
+            speed_text->render();
             time_complexity_text->render();
+
+            if (ServiceLocator::getInstance()->getGameplayService()->isCacheModelEnabled())
+            {
+                cache_misses_text->render();
+                miss_rate_text->render();
+            }
         }
 
         void GameplayUIController::show()
@@ -107,8 +122,11 @@ namespace UI
             array_access_text->show();
 
             num_sticks_text->show();
-            delay_text->show();
+            speed_text->show();
             time_complexity_text->show();
+
+            cache_misses_text->show();
+            miss_rate_text->show();
         }
 
         void GameplayUIController::updateSearchTypeText()
@@ -140,6 +158,26 @@ namespace UI
             case::Gameplay::SortType::RADIX_SORT:
                 search_type_text->setText("Radix Sort");
                 break;
+
+            case::Gameplay::SortType::TIM_SORT:
+                search_type_text->setText("Tim Sort");
+                break;
+
+            case::Gameplay::SortType::HEAP_SORT:
+                search_type_text->setText("Heap Sort");
+                break;
+
+            case::Gameplay::SortType::THREE_WAY_QUICK_SORT:
+                search_type_text->setText("3-Way Quick Sort");
+                break;
+
+            case::Gameplay::SortType::MULTIWAY_MERGE_SORT:
+                search_type_text->setText("Multiway Merge Sort");
+                break;
+
+            case::Gameplay::SortType::EXTERNAL_MERGE_SORT:
+                search_type_text->setText("External Sort");
+                break;
             }
             search_type_text->update();
         }
@@ -171,13 +209,25 @@ namespace UI
             num_sticks_text->update();
         }
 
-        void GameplayUIController::updateDelayText()
+        void GameplayUIController::updateSpeedText()
         {
-            int delay_in_milliseconds = ServiceLocator::getInstance()->getGameplayService()->getDelayMilliseconds();
-            sf::String delay_string = "Delay (ms)  :  " + std::to_string(delay_in_milliseconds);
+            GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
 
-            delay_text->setText(delay_string);
-            delay_text->update();
+            // Clicking the line cycles through the replay speeds, a running sort picks the new one up on its next frame
+            if (clickedText(speed_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                gameplay_service->cycleReplaySpeed();
+            }
+
+            sf::String speed_string = sf::String("Speed  :  ") + gameplay_service->getReplaySpeedTitle();
+
+            // The frame based speeds only say how much gets done per frame, so the measured rate goes next to them
+            if (gameplay_service->getScheduleMode() != ScheduleMode::OPERATIONS_PER_SECOND && gameplay_service->getOperationsPerSecond() > 0)
+                speed_string += "  (" + std::to_string(gameplay_service->getOperationsPerSecond()) + " / s)";
+
+            speed_text->setText(speed_string);
+            speed_text->update();
         }
 
         void GameplayUIController::updateTimeComplexityText()
@@ -189,6 +239,26 @@ namespace UI
             time_complexity_text->update();
         }
 
+        void GameplayUIController::updateCacheTexts()
+        {
+            const Sort::Metrics::CacheStatistics& cache_statistics = ServiceLocator::getInstance()->getGameplayService()->getCacheStatistics();
+
+            sf::String cache_misses_string = "Cache Misses (L1 / L2 / LLC)  :  "
+                + std::to_string(cache_statistics.getMisses(Sort::Metrics::CacheLevel::L1)) + " / "
+                + std::to_string(cache_statistics.getMisses(Sort::Metrics::CacheLevel::L2)) + " / "
+                + std::to_string(cache_statistics.getMisses(Sort::Metrics::CacheLevel::LLC));
+
+            // One decimal is enough to tell the sorts apart
+            int miss_rate_tenths = static_cast<int>(cache_statistics.getMissRate(Sort::Metrics::CacheLevel::L1) * 1000.0 + 0.5);
+            sf::String miss_rate_string = "L1 Miss Rate  :  " + std::to_string(miss_rate_tenths / 10) + "." + std::to_string(miss_rate_tenths % 10) + " %";
+
+            cache_misses_text->setText(cache_misses_string);
+            cache_misses_text->update();
+
+            miss_rate_text->setText(miss_rate_string);
+            miss_rate_text->update();
+        }
+
         void GameplayUIController::menuButtonCallback()
         {
             ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
@@ -201,6 +271,14 @@ namespace UI
             menu_button->registerCallbackFuntion(std::bind(&GameplayUIController::menuButtonCallback, this));
         }
 
+        bool GameplayUIController::clickedText(TextView* text)
+        {
+            sf::RenderWindow* game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+            sf::Vector2f mouse_position = sf::Vector2f(sf::Mouse::getPosition(*game_window));
+
+            return ServiceLocator::getInstance()->getEventService()->pressedLeftMouseButton() && text->getGlobalBounds().contains(mouse_position);
+        }
+
         void GameplayUIController::destroy()
         {
             delete (menu_button);
@@ -208,8 +286,10 @@ namespace UI
             delete (comparisons_text);
             delete (array_access_text);
             delete (num_sticks_text);
-            delete(delay_text);
+            delete(speed_text);
             delete(time_complexity_text);
+            delete(cache_misses_text);
+            delete(miss_rate_text);
         }
     }
 }
\ No newline at end of file
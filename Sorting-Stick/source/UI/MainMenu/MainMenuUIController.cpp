@@ -5,6 +5,7 @@
 #include "Event/EventService.h"
 #include "Global/Config.h"
 #include "Global/ServiceLocator.h"
+#include "Gameplay/GameplayService.h"
 
 namespace UI
 {
@@ -20,6 +21,7 @@ namespace UI
         {
             createImage();
             createButtons();
+            createTexts();
         }
 
         MainMenuUIController::~MainMenuUIController()
@@ -31,6 +33,7 @@ namespace UI
         {
             initializeBackgroundImage();
             initializeButtons();
+            initializeTexts();
             registerButtonCallback();
         }
 
@@ -50,6 +53,16 @@ namespace UI
             quit_button = new ButtonView();
         }
 
+        void MainMenuUIController::createTexts()
+        {
+            input_text = new TextView();
+            tim_sort_text = new TextView();
+            heap_sort_text = new TextView();
+            three_way_quick_sort_text = new TextView();
+            external_sort_text = new TextView();
+            multiway_merge_sort_text = new TextView();
+        }
+
         void MainMenuUIController::initializeBackgroundImage()
         {
             GraphicService* graphic_service = ServiceLocator::getInstance()->getGraphicService();
@@ -71,6 +84,27 @@ namespace UI
             quit_button->setCentreAlinged();
         }
 
+        void MainMenuUIController::initializeTexts()
+        {
+            input_text->initialize("Input  :  Shuffled", sf::Vector2f(0, input_text_y_position), FontType::BUBBLE_BOBBLE, input_text_font_size);
+            updateInputText();
+
+            tim_sort_text->initialize("Tim Sort", sf::Vector2f(0, tim_sort_text_y_position), FontType::BUBBLE_BOBBLE, sort_text_font_size);
+            tim_sort_text->setTextCentreAligned();
+
+            heap_sort_text->initialize("Heap Sort", sf::Vector2f(0, heap_sort_text_y_position), FontType::BUBBLE_BOBBLE, sort_text_font_size);
+            heap_sort_text->setTextCentreAligned();
+
+            three_way_quick_sort_text->initialize("3-Way Quick Sort", sf::Vector2f(0, three_way_quick_sort_text_y_position), FontType::BUBBLE_BOBBLE, sort_text_font_size);
+            three_way_quick_sort_text->setTextCentreAligned();
+
+            external_sort_text->initialize("External Sort", sf::Vector2f(0, external_sort_text_y_position), FontType::BUBBLE_BOBBLE, sort_text_font_size);
+            external_sort_text->setTextCentreAligned();
+
+            multiway_merge_sort_text->initialize("Multiway Merge Sort", sf::Vector2f(0, multiway_merge_sort_text_y_position), FontType::BUBBLE_BOBBLE, sort_text_font_size);
+            multiway_merge_sort_text->setTextCentreAligned();
+        }
+
         void MainMenuUIController::registerButtonCallback()
         {
             bubble_sort_button->registerCallbackFuntion(std::bind(&MainMenuUIController::bubbleSortButtonCallback, this));
@@ -129,6 +163,78 @@ namespace UI
             ServiceLocator::getInstance()->getGraphicService()->getGameWindow()->close();
         }
 
+        void MainMenuUIController::updateInputText()
+        {
+            Gameplay::GameplayService* gameplay_service = ServiceLocator::getInstance()->getGameplayService();
+            Sort::Input::Distribution distribution = gameplay_service->getInputDistribution();
+
+            // Clicking the line cycles through the input distributions the sticks are laid out in, then the dataset if there is one
+            if (clickedText(input_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+
+                int number_of_inputs = Sort::Input::number_of_distributions + (gameplay_service->hasDataset() ? 1 : 0);
+                distribution = static_cast<Sort::Input::Distribution>((static_cast<int>(distribution) + 1) % number_of_inputs);
+                gameplay_service->setInputDistribution(distribution);
+            }
+
+            input_text->setText(sf::String("Input  :  ") + Sort::Input::getDistributionTitle(distribution) + "  (click to change)");
+            input_text->setTextCentreAligned();
+            input_text->update();
+        }
+
+        void MainMenuUIController::updateSortTexts()
+        {
+            if (clickedText(tim_sort_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                Main::GameService::setGameState(GameState::GAMEPLAY);
+                ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::TIM_SORT);
+            }
+
+            if (clickedText(heap_sort_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                Main::GameService::setGameState(GameState::GAMEPLAY);
+                ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::HEAP_SORT);
+            }
+
+            if (clickedText(three_way_quick_sort_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                Main::GameService::setGameState(GameState::GAMEPLAY);
+                ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::THREE_WAY_QUICK_SORT);
+            }
+
+            if (clickedText(external_sort_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                Main::GameService::setGameState(GameState::GAMEPLAY);
+                ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::EXTERNAL_MERGE_SORT);
+            }
+
+            if (clickedText(multiway_merge_sort_text))
+            {
+                ServiceLocator::getInstance()->getSoundService()->playSound(SoundType::BUTTON_CLICK);
+                Main::GameService::setGameState(GameState::GAMEPLAY);
+                ServiceLocator::getInstance()->getGameplayService()->sortElement(Gameplay::Collection::SortType::MULTIWAY_MERGE_SORT);
+            }
+
+            tim_sort_text->update();
+            heap_sort_text->update();
+            three_way_quick_sort_text->update();
+            external_sort_text->update();
+            multiway_merge_sort_text->update();
+        }
+
+        bool MainMenuUIController::clickedText(TextView* text)
+        {
+            sf::RenderWindow* game_window = ServiceLocator::getInstance()->getGraphicService()->getGameWindow();
+            sf::Vector2f mouse_position = sf::Vector2f(sf::Mouse::getPosition(*game_window));
+
+            return ServiceLocator::getInstance()->getEventService()->pressedLeftMouseButton() && text->getGlobalBounds().contains(mouse_position);
+        }
+
         void MainMenuUIController::update()
         {
             background_image->update();
@@ -139,6 +245,8 @@ namespace UI
             quick_sort_button->update();
             radix_sort_button->update();
             quit_button->update();
+            updateInputText();
+            updateSortTexts();
         }
 
         void MainMenuUIController::render()
@@ -151,6 +259,12 @@ namespace UI
             quick_sort_button->render();
             radix_sort_button->render();
             quit_button->render();
+            input_text->render();
+            tim_sort_text->render();
+            heap_sort_text->render();
+            three_way_quick_sort_text->render();
+            external_sort_text->render();
+            multiway_merge_sort_text->render();
         }
 
         void MainMenuUIController::show()
@@ -163,6 +277,12 @@ namespace UI
             quick_sort_button->show();
             radix_sort_button->show();
             quit_button->show();
+            input_text->show();
+            tim_sort_text->show();
+            heap_sort_text->show();
+            three_way_quick_sort_text->show();
+            external_sort_text->show();
+            multiway_merge_sort_text->show();
         }
 
         void MainMenuUIController::destroy()
@@ -174,6 +294,12 @@ namespace UI
             delete (quick_sort_button);
             delete (radix_sort_button);
             delete (quit_button);
+            delete (input_text);
+            delete (tim_sort_text);
+            delete (heap_sort_text);
+            delete (three_way_quick_sort_text);
+            delete (external_sort_text);
+            delete (multiway_merge_sort_text);
             delete (background_image);
         }
     }
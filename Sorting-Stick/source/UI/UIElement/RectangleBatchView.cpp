@@ -0,0 +1,62 @@
+#include "UI/UIElement/RectangleBatchView.h"
+
+namespace UI
+{
+	namespace UIElement
+	{
+		RectangleBatchView::RectangleBatchView() = default;
+
+		RectangleBatchView::~RectangleBatchView() = default;
+
+		void RectangleBatchView::initialize(int rectangle_count)
+		{
+			UIView::initialize();
+
+			rectangle_vertices.setPrimitiveType(sf::Triangles);
+			rectangle_vertices.resize(rectangle_count * vertices_per_rectangle);
+		}
+
+		void RectangleBatchView::update()
+		{
+			UIView::update();
+		}
+
+		void RectangleBatchView::render()
+		{
+			UIView::render();
+
+			if (ui_state == UIState::VISIBLE)
+			{
+				game_window->draw(rectangle_vertices);
+			}
+		}
+
+		void RectangleBatchView::setRectangle(int index, sf::Vector2f rectangle_size, sf::Vector2f rectangle_position)
+		{
+			sf::Vector2f size = getScaleForCurrentResolution(rectangle_size.x, rectangle_size.y);
+			sf::Vector2f top_left = getPositionForCurrentResolution(rectangle_position);
+			sf::Vector2f bottom_right = top_left + size;
+
+			sf::Vertex* vertices = &rectangle_vertices[index * vertices_per_rectangle];
+
+			vertices[0].position = top_left;
+			vertices[1].position = sf::Vector2f(bottom_right.x, top_left.y);
+			vertices[2].position = bottom_right;
+			vertices[3].position = top_left;
+			vertices[4].position = bottom_right;
+			vertices[5].position = sf::Vector2f(top_left.x, bottom_right.y);
+		}
+
+		void RectangleBatchView::setFillColor(int index, sf::Color fill_color)
+		{
+			sf::Vertex* vertices = &rectangle_vertices[index * vertices_per_rectangle];
+
+			for (int i = 0; i < vertices_per_rectangle; i++) vertices[i].color = fill_color;
+		}
+
+		int RectangleBatchView::getRectangleCount()
+		{
+			return static_cast<int>(rectangle_vertices.getVertexCount()) / vertices_per_rectangle;
+		}
+	}
+}
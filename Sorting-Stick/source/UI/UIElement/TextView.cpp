@@ -91,5 +91,10 @@ namespace UI
 
 			text.setPosition(sf::Vector2f(x_position, y_position));
 		}
+
+		sf::FloatRect TextView::getGlobalBounds() const
+		{
+			return text.getGlobalBounds();
+		}
 	}
 }
\ No newline at end of file